@@ -7,30 +7,235 @@
 #ifndef TIMON_PASSLICK_ARRAY_LIB
 #define TIMON_PASSLICK_ARRAY_LIB
 
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#elif !defined(PROGMEM)
+//PCs and boards without a pgmspace.h can read constants directly, so PROGMEM means nothing there.
+#define PROGMEM
+#endif
+
 #ifndef ARRAY_LIB_PLACEMENT_NEW_DEFINED
 //DEFINED FOR THE WHOLE INO FILE, I KNOW NO OTHER WAY
 //You can turn this off by defining the flag above
 void* operator new(size_t, void* p) { return p; } //placement new
 #endif
 
+//Element types which can be copied with a plain memcpy are trivially copyable.
+//Arrays of them are copied in bulk. The compiler knows which types are, so you don't need to opt them in.
+//The traits use compiler builtins because <type_traits> is not available on every Arduino.
+template <typename T>
+struct TriviallyCopyable {
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5)
+  static constexpr bool value = __is_trivially_copyable(T);
+#else
+  static constexpr bool value = __has_trivial_copy(T) && __has_trivial_assign(T) && __has_trivial_destructor(T);
+#endif
+};
+
+//Element types whose destructor does nothing are trivially destructible.
+//Arrays of them skip destroying their elements one by one.
+template <typename T>
+struct TriviallyDestructible {
+#if defined(__clang__)
+  static constexpr bool value = __is_trivially_destructible(T);
+#else
+  static constexpr bool value = __has_trivial_destructor(T);
+#endif
+};
+
+//Element types which can be moved to another address with a plain memcpy are trivially relocatable.
+//Arrays of them are grown with realloc, which can often just extend the allocated block in place.
+//All trivially copyable and destructible types are. Many other types are too, for example classes which only own a heap block, and you can opt them in like this:
+//ARRAY_LIB_TRIVIALLY_RELOCATABLE(Message)
+//The macro only works for a single type. For a class template, write a partial specialization of TriviallyRelocatable like the macro does.
+template <typename T>
+struct TriviallyRelocatable {
+  static constexpr bool value = TriviallyCopyable<T>::value && TriviallyDestructible<T>::value;
+};
+
+#define ARRAY_LIB_TRIVIALLY_RELOCATABLE(T) \
+  template <> \
+  struct TriviallyRelocatable<T> { \
+    static constexpr bool value = true; \
+  };
+
+//internal helpers, you don't need them to use the library
+namespace array_lib_internal {
+
+  //used to choose between two implementations of a function at compile time
+  template <bool> struct BoolTag { };
+
+  //the parts of <utility> we need, because it is not available on every Arduino
+  template <typename T> struct RemoveReference       {using type = T;};
+  template <typename T> struct RemoveReference<T&>  {using type = T;};
+  template <typename T> struct RemoveReference<T&&> {using type = T;};
+
+  //and the parts of <type_traits>
+  template <typename U, typename T> struct IsSame {static constexpr bool value{false};};
+  template <typename T> struct IsSame<T, T>       {static constexpr bool value{true};};
+
+  template <bool Condition> struct EnableIf { };
+  template <> struct EnableIf<true>         {using type = void;};
+
+  template <typename T>
+  inline typename RemoveReference<T>::type&& move(T&& arg) {
+    return static_cast<typename RemoveReference<T>::type&&>(arg);
+  }
+
+  template <typename T>
+  inline T&& forward(typename RemoveReference<T>::type& arg) {
+    return static_cast<T&&>(arg);
+  }
+
+  template <typename T>
+  inline T&& forward(typename RemoveReference<T>::type&& arg) {
+    return static_cast<T&&>(arg);
+  }
+
+  //copy constructs count elements from source in uninitialized memory at destination
+  template <typename T>
+  inline void copy_construct(T* const destination, const T* const source, const size_t count, BoolTag<true>) {
+    if (count != 0) {
+      memcpy(destination, source, count * sizeof(T));
+    }
+  }
+
+  template <typename T>
+  inline void copy_construct(T* const destination, const T* const source, const size_t count, BoolTag<false>) {
+    for (size_t i{0}; i != count; ++i) {
+      new (destination + i) T(source[i]); //calling the copy constructor with source[i] explicitly at destination[i]
+    }
+  }
+
+  template <typename T>
+  inline void copy_construct(T* const destination, const T* const source, const size_t count) {
+    copy_construct(destination, source, count, BoolTag<TriviallyCopyable<T>::value>{});
+  }
+
+  //copy constructs count elements from value in uninitialized memory at destination
+  //Single bytes are filled with memset.
+  template <typename T>
+  inline void fill_construct(T* const destination, const size_t count, const T& value, BoolTag<true>) {
+    memset(destination, *reinterpret_cast<const unsigned char*>(&value), count);
+  }
+
+  template <typename T>
+  inline void fill_construct(T* const destination, const size_t count, const T& value, BoolTag<false>) {
+    for (size_t i{0}; i != count; ++i) {
+      new (destination + i) T(value); //calling the copy constructor with value explicitly at destination[i]
+    }
+  }
+
+  template <typename T>
+  inline void fill_construct(T* const destination, const size_t count, const T& value) {
+    fill_construct(destination, count, value, BoolTag<sizeof(T) == 1 && TriviallyCopyable<T>::value>{});
+  }
+
+  //calls the destructors of count elements, which does nothing for trivially destructible elements
+  template <typename T>
+  inline void destroy(T*, size_t, BoolTag<true>) { }
+
+  template <typename T>
+  inline void destroy(T* const elements, const size_t count, BoolTag<false>) {
+    for (size_t i{0}; i != count; ++i) {
+      elements[i].~T();
+    }
+  }
+
+  template <typename T>
+  inline void destroy(T* const elements, const size_t count) {
+    destroy(elements, count, BoolTag<TriviallyDestructible<T>::value>{});
+  }
+
+  //uninitialized space for N elements inside of an object, aligned at least like T
+  //Classes inherit from it so that it takes no space at all for N == 0.
+  template <typename T, size_t N, size_t Alignment = 1>
+  struct InlineStorage {
+    T* inline_elements() {
+      return reinterpret_cast<T*>(bytes);
+    }
+
+    alignas(T) alignas(Alignment) unsigned char bytes[N * sizeof(T)];
+  };
+
+  template <typename T, size_t Alignment>
+  struct InlineStorage<T, 0, Alignment> {
+    T* inline_elements() {
+      return nullptr;
+    }
+  };
+
+  //tells the compiler that the pointer is a multiple of Alignment, so it can use aligned vector instructions in loops over it
+  template <size_t Alignment, typename T>
+  inline T* assume_aligned(T* const pointer) {
+#if defined(__GNUC__)
+    return static_cast<T*>(__builtin_assume_aligned(pointer, Alignment));
+#else
+    return pointer;
+#endif
+  }
+
+}
+
 //returns the length of a C array
 template <typename T, size_t N>
 inline constexpr size_t length(const T(&)[N]) {
   return N;
 }
 
+//Bounds checking policies decide whether operator[] crashes the program when the index is bigger than the array size.
+//Every array type takes one as its last template parameter. The default is CheckedBounds, you can change it for all arrays by defining ARRAY_LIB_DEFAULT_BOUNDS before including this file:
+//  #define ARRAY_LIB_DEFAULT_BOUNDS DebugBounds
+//No matter which policy you choose, at() always checks and unchecked() never does.
+
+//always checks
+struct CheckedBounds {
+  static constexpr bool checks = true;
+};
+
+//only checks if NDEBUG is not defined, so it is as fast as UncheckedBounds in release builds
+struct DebugBounds {
+#ifdef NDEBUG
+  static constexpr bool checks = false;
+#else
+  static constexpr bool checks = true;
+#endif
+};
+
+//never checks: Accessing an element out of bounds then silently reads or writes other memory.
+struct UncheckedBounds {
+  static constexpr bool checks = false;
+};
+
+#ifndef ARRAY_LIB_DEFAULT_BOUNDS
+#define ARRAY_LIB_DEFAULT_BOUNDS CheckedBounds
+#endif
+using DefaultBounds = ARRAY_LIB_DEFAULT_BOUNDS;
+
+
+//the extent of an ArrayView whose length is only known when the program runs
+constexpr size_t DynamicExtent{static_cast<size_t>(-1)};
+
+//a view of elements which are stored somewhere else, see below
+template <typename T, size_t Extent = DynamicExtent, typename Bounds = DefaultBounds>
+class ArrayView;
+
+
 //an array with a size which is known before the program runs
 //You can tell with 'constexpr' in front of a variable declaration that you know also the contents of the array before the array runs and they won't change.
-template <typename T, size_t N>
+template <typename T, size_t N, typename Bounds = DefaultBounds>
 struct StackArray {
 
   //A stack_array is a wrapper around a C array which is a public member.
   T c_array[N];
 
   //You can access the elements of the array at runtime just like with C arrays.
-  //If the index is bigger than the array size, the program will crash.
+  //If the index is bigger than the array size, the program will crash unless the bounds checking policy says otherwise.
   T& operator [] (const size_t index) {
-    if (index >= N) {
+    if (Bounds::checks && index >= N) {
       abort();
     }
     return c_array[index];
@@ -38,11 +243,59 @@ struct StackArray {
 
   //You can also access the elements of the array before the program runs. Don't forget to declare the variable 'constexpr', though.
   constexpr const T& operator [] (const size_t index) const {
+    return (!Bounds::checks || index < N) ? c_array[index] : constexpr_stack_array_index_out_of_bounds();
+  }
+
+  //like operator [], but always crashes the program if the index is bigger than the array size
+  T& at(const size_t index) {
+    if (index >= N) {
+      abort();
+    }
+    return c_array[index];
+  }
+
+  constexpr const T& at(const size_t index) const {
     return (index < N) ? c_array[index] : constexpr_stack_array_index_out_of_bounds();
   }
 
+  //like operator [], but never checks the index, for loops where you know it is fine and every cycle counts
+  T& unchecked(const size_t index) {
+    return c_array[index];
+  }
+
+  constexpr const T& unchecked(const size_t index) const {
+    return c_array[index];
+  }
+
+  //You can loop over the elements like this: for (int& element : array) { ... }
+  //The iterators are plain pointers, so you can also pass them to anything which expects a pointer to the first and behind the last element.
+  T* begin() {
+    return c_array;
+  }
+
+  constexpr const T* begin() const {
+    return c_array;
+  }
+
+  T* end() {
+    return c_array + N;
+  }
+
+  constexpr const T* end() const {
+    return c_array + N;
+  }
+
+  //the pointer to the first element, for functions which take a C array
+  T* data() {
+    return c_array;
+  }
+
+  constexpr const T* data() const {
+    return c_array;
+  }
+
   //You can access the length before and when the program runs.
-  constexpr size_t length() {
+  constexpr size_t length() const {
     return N;
   }
 
@@ -55,142 +308,1792 @@ struct StackArray {
 };
 
 
-//an array with a size which is known when the program runs and won't change
-template <typename T>
-class HeapArray {
+namespace array_lib_internal {
 
-  private:
-    //A HeapArray is internally a dynamic array with a stored size.
-    T* begin;
-    size_t size;
+  //a list of the indices 0 to N - 1, made by splitting it in halves so that big tables don't hit the compiler's recursion limit
+  template <size_t... I> struct Indices { };
 
-  public:
+  template <typename First, typename Second> struct ConcatenateIndices;
+  template <size_t... First, size_t... Second>
+  struct ConcatenateIndices<Indices<First...>, Indices<Second...>> {
+    using type = Indices<First..., (sizeof...(First) + Second)...>;
+  };
 
-    //When constructing a HeapArray, you must provide its size.
-    //All elements are default initialized.
-    HeapArray(size_t length) : begin{new T[length]}, size{length} { }
+  template <size_t N> struct MakeIndices {
+    using type = typename ConcatenateIndices<typename MakeIndices<N / 2>::type, typename MakeIndices<N - N / 2>::type>::type;
+  };
+  template <> struct MakeIndices<0> {using type = Indices<>;};
+  template <> struct MakeIndices<1> {using type = Indices<0>;};
 
-    HeapArray(HeapArray&& temp) : begin{temp.begin}, size{temp.size} {
-      temp.begin = nullptr;
-      temp.size = 0;
-    }
+  template <typename T, size_t N, typename Bounds, typename Generator, size_t... I>
+  constexpr StackArray<T, N, Bounds> make_stack_array(const Generator& generator, Indices<I...>) {
+    return StackArray<T, N, Bounds>{{T(generator(I))...}};
+  }
 
-    //You have to copy the HeapArray explicitly. That prevents you from accidentally passing it by value.
-    HeapArray(const HeapArray&) = delete;
-    HeapArray copy() {
-      HeapArray<T> result{0};
-      result.begin = new T[size];
-      result.size = size;
-      for (size_t i{0}; i != size; ++i) {
-        new (result.begin + i) T(begin[i]); //calling the copy constructor with begin[i] explicitly at result.begin[i]
-      }
-      return result;
-    }
+}
 
-    //You can access the elements just like with C arrays.
-    //If the index is bigger than the array size, the program will crash.
-    T& operator [] (const size_t index) {
-      if (index >= size) {
-        abort();
-      }
-      return begin[index];
-    }
+//creates a StackArray whose element i is generator(i)
+//If the generator is a constexpr function or an object with a constexpr operator (), this happens before the program runs, so you can compute tables instead of pasting them:
+//  constexpr uint16_t square(size_t i) { return i * i; }
+//  constexpr auto squares = make_stack_array<uint16_t, 16>(square);
+template <typename T, size_t N, typename Bounds = DefaultBounds, typename Generator>
+constexpr StackArray<T, N, Bounds> make_stack_array(const Generator& generator) {
+  return array_lib_internal::make_stack_array<T, N, Bounds>(generator, typename array_lib_internal::MakeIndices<N>::type{});
+}
 
-    //You can access the length.
-    size_t length() {
-      return size;
+//compares with <, the default order for sorting and searching
+struct Less {
+  template <typename T>
+  constexpr bool operator () (const T& first, const T& second) const {
+    return first < second;
+  }
+};
+
+namespace array_lib_internal {
+
+  //The functions for sorting and searching StackArrays before the program runs may only consist of one return statement.
+  //They can't use loops, so they split ranges in halves and recurse instead, which keeps the recursion depth at log2(N).
+
+  //how many elements come before element j in the sorted order, with equal elements staying in their order
+  template <typename T, size_t N, typename Bounds, typename Compare>
+  constexpr size_t rank(const StackArray<T, N, Bounds>& array, const size_t j, const Compare& compare, const size_t first, const size_t last) {
+    return last - first == 0 ? 0
+      : last - first == 1 ? ((compare(array.c_array[first], array.c_array[j]) || (first < j && !compare(array.c_array[j], array.c_array[first]))) ? 1 : 0)
+      : rank(array, j, compare, first, first + (last - first) / 2) + rank(array, j, compare, first + (last - first) / 2, last);
+  }
+
+  template <typename T, size_t N, typename Bounds, typename Compare, size_t... I>
+  constexpr StackArray<size_t, N> ranks(const StackArray<T, N, Bounds>& array, const Compare& compare, Indices<I...>) {
+    return StackArray<size_t, N>{{rank(array, I, compare, 0, N)...}};
+  }
+
+  //the smaller of two indices, where N stands for "not found"
+  constexpr size_t first_index(const size_t first, const size_t second) {
+    return first < second ? first : second;
+  }
+
+  //the index of the element with the given rank
+  template <size_t N>
+  constexpr size_t with_rank(const StackArray<size_t, N>& ranks, const size_t rank, const size_t first, const size_t last) {
+    return last - first == 0 ? N
+      : last - first == 1 ? (ranks.c_array[first] == rank ? first : N)
+      : first_index(with_rank(ranks, rank, first, first + (last - first) / 2), with_rank(ranks, rank, first + (last - first) / 2, last));
+  }
+
+  template <typename T, size_t N, typename Bounds, size_t... I>
+  constexpr StackArray<T, N, Bounds> sorted(const StackArray<T, N, Bounds>& array, const StackArray<size_t, N>& ranks, Indices<I...>) {
+    return StackArray<T, N, Bounds>{{array.c_array[with_rank(ranks, I, 0, N)]...}};
+  }
+
+  template <typename T, size_t N, typename Bounds, typename Compare>
+  constexpr size_t lower_bound(const StackArray<T, N, Bounds>& array, const T& value, const Compare& compare, const size_t first, const size_t last) {
+    return first == last ? first
+      : compare(array.c_array[first + (last - first) / 2], value) ? lower_bound(array, value, compare, first + (last - first) / 2 + 1, last)
+      : lower_bound(array, value, compare, first, first + (last - first) / 2);
+  }
+
+  template <typename T, size_t N, typename Bounds>
+  constexpr size_t find(const StackArray<T, N, Bounds>& array, const T& value, const size_t first, const size_t last) {
+    return last - first == 0 ? N
+      : last - first == 1 ? (array.c_array[first] == value ? first : N)
+      : first_index(find(array, value, first, first + (last - first) / 2), find(array, value, first + (last - first) / 2, last));
+  }
+
+  //In the Eytzinger layout, the sorted elements are stored like a binary search tree in breadth first order:
+  //The root is at node 1 and the children of node k are at 2k and 2k + 1, where node k is stored at index k - 1.
+  //A search then reads the elements from front to back, which is much friendlier to caches and branch predictors.
+
+  //the number of nodes in the subtree whose level starts with node first and ends with node last
+  constexpr size_t subtree_size(const size_t first, const size_t last, const size_t n) {
+    return first > n ? 0 : ((last < n ? last : n) - first + 1) + subtree_size(2 * first, 2 * last + 1, n);
+  }
+
+  //the index in the sorted order of the element at node k
+  constexpr size_t sorted_index(const size_t k, const size_t n) {
+    return k == 1 ? subtree_size(2, 2, n)
+      : k % 2 == 0 ? sorted_index(k / 2, n) - subtree_size(2 * k + 1, 2 * k + 1, n) - 1
+      : sorted_index(k / 2, n) + subtree_size(2 * k, 2 * k, n) + 1;
+  }
+
+  template <typename T, size_t N, typename Bounds, size_t... I>
+  constexpr StackArray<T, N, Bounds> eytzinger(const StackArray<T, N, Bounds>& sorted, Indices<I...>) {
+    return StackArray<T, N, Bounds>{{sorted.c_array[sorted_index(I + 1, N)]...}};
+  }
+
+  //goes down the tree, to the right child if the element is smaller than value, until it falls out of it
+  template <typename T, size_t N, typename Bounds, typename Compare>
+  constexpr size_t eytzinger_descend(const StackArray<T, N, Bounds>& layout, const T& value, const Compare& compare, const size_t k) {
+    return k > N ? k : eytzinger_descend(layout, value, compare, 2 * k + (compare(layout.c_array[k - 1], value) ? 1 : 0));
+  }
+
+  //The answer is the node where the search went left the last time, so the right turns after it are removed.
+  constexpr size_t eytzinger_last_left_turn(const size_t k) {
+    return k % 2 == 1 ? eytzinger_last_left_turn(k / 2) : k / 2;
+  }
+
+}
+
+//returns a copy of the array in ascending order, which also works before the program runs:
+//  constexpr auto commands = sorted(StackArray<int, 4>{30, 10, 40, 20});
+//You can pass a different order as the second argument, for example an object with a constexpr operator () which compares names.
+//Equal elements keep their order. It needs about N * N comparisons, which is fine for tables computed by the compiler.
+template <typename T, size_t N, typename Bounds, typename Compare = Less>
+constexpr StackArray<T, N, Bounds> sorted(const StackArray<T, N, Bounds>& array, const Compare& compare = Compare{}) {
+  return array_lib_internal::sorted(array, array_lib_internal::ranks(array, compare, typename array_lib_internal::MakeIndices<N>::type{}), typename array_lib_internal::MakeIndices<N>::type{});
+}
+
+//returns the index of the first element of a sorted array which is not smaller than value, or the length if there is none
+template <typename T, size_t N, typename Bounds, typename Compare = Less>
+constexpr size_t lower_bound(const StackArray<T, N, Bounds>& array, const T& value, const Compare& compare = Compare{}) {
+  return array_lib_internal::lower_bound(array, value, compare, 0, N);
+}
+
+//returns whether a sorted array contains value
+template <typename T, size_t N, typename Bounds, typename Compare = Less>
+constexpr bool binary_search(const StackArray<T, N, Bounds>& array, const T& value, const Compare& compare = Compare{}) {
+  return lower_bound(array, value, compare) != N && !compare(value, array.c_array[lower_bound(array, value, compare)]);
+}
+
+//returns the index of the first element which is equal to value, or the length if there is none
+//The array doesn't need to be sorted.
+template <typename T, size_t N, typename Bounds>
+constexpr size_t find(const StackArray<T, N, Bounds>& array, const T& value) {
+  return array_lib_internal::find(array, value, 0, N);
+}
+
+//rearranges a sorted array into the Eytzinger layout for eytzinger_lower_bound, which is faster than binary search for big tables
+template <typename T, size_t N, typename Bounds>
+constexpr StackArray<T, N, Bounds> eytzinger(const StackArray<T, N, Bounds>& sorted) {
+  return array_lib_internal::eytzinger(sorted, typename array_lib_internal::MakeIndices<N>::type{});
+}
+
+//returns the index in an array in Eytzinger layout of the smallest element which is not smaller than value, or the length if there is none
+template <typename T, size_t N, typename Bounds, typename Compare = Less>
+constexpr size_t eytzinger_lower_bound(const StackArray<T, N, Bounds>& layout, const T& value, const Compare& compare = Compare{}) {
+  return array_lib_internal::eytzinger_last_left_turn(array_lib_internal::eytzinger_descend(layout, value, compare, 1)) == 0 ? N
+    : array_lib_internal::eytzinger_last_left_turn(array_lib_internal::eytzinger_descend(layout, value, compare, 1)) - 1;
+}
+
+namespace array_lib_internal {
+
+  template <size_t Bytes> struct SizeTag { };
+
+#if defined(__AVR__)
+  //On AVR, flash memory has its own address space, so it can only be read with special instructions.
+  //There is one for each of the usual sizes, bigger elements are copied byte by byte.
+  template <typename T>
+  inline T read_flash(const T* const pointer, SizeTag<1>) {
+    const uint8_t byte{pgm_read_byte(pointer)};
+    T value;
+    memcpy(&value, &byte, 1);
+    return value;
+  }
+
+  template <typename T>
+  inline T read_flash(const T* const pointer, SizeTag<2>) {
+    const uint16_t word{pgm_read_word(pointer)};
+    T value;
+    memcpy(&value, &word, 2);
+    return value;
+  }
+
+  template <typename T>
+  inline T read_flash(const T* const pointer, SizeTag<4>) {
+    const uint32_t double_word{pgm_read_dword(pointer)};
+    T value;
+    memcpy(&value, &double_word, 4);
+    return value;
+  }
+
+  template <typename T, size_t Bytes>
+  inline T read_flash(const T* const pointer, SizeTag<Bytes>) {
+    T value;
+    memcpy_P(&value, pointer, Bytes);
+    return value;
+  }
+#endif
+
+  //reads an element of a FlashArray
+  template <typename T>
+  inline T read_flash(const T* const pointer) {
+#if defined(__AVR__)
+    return read_flash(pointer, SizeTag<sizeof(T)>{});
+#elif defined(pgm_read_byte)
+    //Other boards with a pgmspace.h, like the ESP8266, can have flash which can't be read directly either.
+    //Their memcpy_P knows how to read it, even at addresses which are not aligned.
+    T value;
+    memcpy_P(&value, pointer, sizeof(T));
+    return value;
+#else
+    return *pointer;
+#endif
+  }
+
+}
+
+//a StackArray for constant tables which stays in flash memory instead of being copied to RAM when the program starts, like CRC or sine tables
+//You must declare it const and PROGMEM at file scope or static, otherwise it is copied to RAM anyway:
+//  const FlashArray<uint8_t, 4> steps PROGMEM {1, 2, 4, 8};
+//Reading an element copies it from flash, so operator [] returns a copy instead of a reference and the elements must be plain values.
+//On boards whose core has a pgmspace.h, like the ESP8266, the elements are read with memcpy_P.
+//On PCs and other boards, PROGMEM does nothing and the elements are read directly.
+template <typename T, size_t N, typename Bounds = DefaultBounds>
+struct FlashArray {
+
+  static_assert(TriviallyCopyable<T>::value, "only plain values can be read from flash memory");
+
+  //A FlashArray is a wrapper around a C array in flash memory which is a public member. Don't read it directly on AVR!
+  T c_array[N];
+
+  //If the index is bigger than the array size, the program will crash unless the bounds checking policy says otherwise.
+  T operator [] (const size_t index) const {
+    if (Bounds::checks && index >= N) {
+      abort();
     }
+    return array_lib_internal::read_flash(c_array + index);
+  }
 
-    ~HeapArray(){
-      delete[] begin;
+  //like operator [], but always crashes the program if the index is bigger than the array size
+  T at(const size_t index) const {
+    if (index >= N) {
+      abort();
     }
+    return array_lib_internal::read_flash(c_array + index);
+  }
+
+  //like operator [], but never checks the index, for loops where you know it is fine and every cycle counts
+  T unchecked(const size_t index) const {
+    return array_lib_internal::read_flash(c_array + index);
+  }
+
+  //You can access the length before and when the program runs.
+  constexpr size_t length() const {
+    return N;
+  }
 };
 
 
-//a growing array: You can push elements onto its end.
-template <typename T>
-class GrowingArray {
+//Allocators give HeapArray and GrowingArray their memory.
+//An allocator is a type with these static functions:
+//  void* allocate(size_t bytes) returns a block with at least this size which is aligned for any type, or nullptr if there is no memory left.
+//  void deallocate(void* block) gives a block back.
+//It can also have these, which let arrays grow or shrink without moving their elements:
+//  bool try_extend(void* block, size_t old_bytes, size_t new_bytes) resizes the block in place if possible and returns whether it did.
+//  void* reallocate(void* block, size_t old_bytes, size_t new_bytes) resizes the block like realloc, which may copy its bytes to a new place.
+//If its blocks are aligned more strictly, it can say so with static constexpr size_t alignment, see AlignedAllocator below.
+//The arrays never ask for 0 bytes and never give back nullptr.
 
-  private:
-    //A GrowingArray is internally allocated heap space.
-    //It is not reallocated for every new element, so we need to store a capacity.
-    T* begin;
-    size_t size;
-    size_t capacity;
+//the default allocator which uses the heap
+struct MallocAllocator {
+  static void* allocate(const size_t bytes) {
+    return malloc(bytes);
+  }
 
+  static void deallocate(void* const block) {
+    free(block);
+  }
 
-  public:
-    //For the sake of simplicity, there is just a default constructor which creates an empty growing_array.
-    GrowingArray() : begin{nullptr}, size{0}, capacity{0} { }
+  static void* reallocate(void* const block, size_t, const size_t new_bytes) {
+    return realloc(block, new_bytes);
+  }
+};
 
-    GrowingArray(GrowingArray&& temp) : begin{temp.begin}, size{temp.size}, capacity{temp.capacity} {
-      temp.begin = nullptr;
-      temp.size = 0;
-    }
-    
-    //You have to copy the HeapArray explicitly. That prevents you from accidentally passing it by value.
-    GrowingArray(const GrowingArray&) = delete;
-    GrowingArray copy() {
-      GrowingArray<T> result;
-      result.begin = reinterpret_cast<T*>(malloc(size * sizeof(T)));
-      result.size = size;
-      result.capacity = size;
-      for (size_t i{0}; i != size; ++i) {
-        new (result.begin + i) T(begin[i]); //calling the copy constructor with begin[i] explicitly at result.begin[i]
-      }
-      return result;
-    }
+namespace array_lib_internal {
 
-    //You can access the elements just like with C arrays.
-    //If the index is bigger than the array size, the program will crash.
-    T& operator [] (const size_t index) {
-      if (index >= size) {
-        abort();
-      }
-      return begin[index];
-    }
+  //a type with the strictest alignment of the usual types
+  //Allocators align their blocks like this so they can hold any element type.
+  union MaxAlign {
+    long long integer;
+    long double floating_point;
+    void* pointer;
+    void (*function_pointer)();
+  };
 
-    //pushes an item to the back of the vector
-    //The item is copied. If you notice a performance bottleneck for growing_array insertion, you might want to extend this class.
-    //The array might get reallocated, so references you got by accessing an element get invalidated.
-    void push(const T& item) {
-      if (size == capacity) {
-        if (capacity == 0) {
-          capacity = 1;
-        }
-        //not the usual * 2 because memory space on Arduinos is sparse
-        capacity = (capacity * 3 + 1) / 2;
-        auto new_begin = reinterpret_cast<T*>(malloc(capacity * sizeof(T)));
-        for (size_t i{0}; i != size; ++i) {
-          new (new_begin + i) T(move(begin[i])); //calling the move constructor with begin[i] explicitly at new_begin[i]
-        }
-        begin = new_begin;
-      }
-      begin[size] = item;
-      ++size;
-    }
+}
 
-    //You can read the size but not change it directly.
-    size_t length() {
-      return size;
+//a bump allocator which hands out the static buffer of Bytes bytes from front to back
+//Allocating just moves a counter forward and deallocating does nothing, so it is fast and the memory never gets fragmented.
+//Instead, you give the memory back all at once by resetting the arena, for example at the end of every loop():
+//  using Scratch = ArenaAllocator<256>;
+//  ...
+//  {
+//    GrowingArray<int, GrowByHalf, Scratch> samples;
+//    ...
+//  }
+//  Scratch::reset(); //Only reset when the arrays in the arena are gone!
+//If you need two arenas of the same size, tell them apart with a tag type: ArenaAllocator<256, struct SensorTag>
+template <size_t Bytes, typename Tag = void>
+struct ArenaAllocator {
+
+  static void* allocate(const size_t bytes) {
+    const size_t start{(used + alignof(array_lib_internal::MaxAlign) - 1) / alignof(array_lib_internal::MaxAlign) * alignof(array_lib_internal::MaxAlign)};
+    if (start > Bytes || bytes > Bytes - start) {
+      return nullptr;
     }
+    used = start + bytes;
+    return buffer + start;
+  }
 
-    ~GrowingArray() {
-      for (int i = 0; i != size; ++i) {
-        begin[i].~T();
-      }
-      free(begin);
+  static void deallocate(void*) { }
+
+  //The block which was allocated last can grow and shrink in place, so a GrowingArray in an arena doesn't need to move.
+  static bool try_extend(void* const block, const size_t old_bytes, const size_t new_bytes) {
+    const size_t start = static_cast<unsigned char*>(block) - buffer;
+    if (start + old_bytes != used || new_bytes > Bytes - start) {
+      return false;
     }
+    used = start + new_bytes;
+    return true;
+  }
+
+  //You can remember how much of the arena is used and later give back everything which was allocated after that.
+  static size_t mark() {
+    return used;
+  }
+
+  static void reset(const size_t mark = 0) {
+    used = mark;
+  }
+
+  //how many bytes are left, not counting padding for alignment
+  static size_t available() {
+    return Bytes - used;
+  }
 
   private:
+  alignas(array_lib_internal::MaxAlign) static unsigned char buffer[Bytes];
+  static size_t used;
+};
+
+template <size_t Bytes, typename Tag>
+alignas(array_lib_internal::MaxAlign) unsigned char ArenaAllocator<Bytes, Tag>::buffer[Bytes];
 
-    template< typename Ty > struct remove_reference       {using type = Ty;};
-    template< typename Ty > struct remove_reference<Ty&>  {using type = Ty;};
-    template< typename Ty > struct remove_reference<Ty&&> {using type = Ty;};
+template <size_t Bytes, typename Tag>
+size_t ArenaAllocator<Bytes, Tag>::used{0};
 
-    template <typename Ty>
-    typename remove_reference<Ty>::type&& move(Ty&& arg) {
-      return static_cast<typename remove_reference<Ty>::type&&>(arg);
+//an allocator with a static pool of Count blocks of BlockSize bytes each
+//Allocating and deallocating just takes a block from or puts it onto a list of free blocks, so it is fast and the memory never gets fragmented.
+//It is meant for many arrays of the same size, like message buffers:
+//  HeapArray<uint8_t, PoolAllocator<32, 16>> message{32};
+//Asking for more than BlockSize bytes fails like a full heap.
+//If you need two pools of the same size, tell them apart with a tag type: PoolAllocator<32, 16, struct MessageTag>
+template <size_t BlockSize, size_t Count, typename Tag = void>
+struct PoolAllocator {
+
+  static void* allocate(const size_t bytes) {
+    if (bytes > BlockSize) {
+      return nullptr;
+    }
+    if (free_blocks != nullptr) {
+      Block* const block{free_blocks};
+      free_blocks = block->next;
+      return block;
+    }
+    //The blocks which were never used are not on the list, so the pool needs no setup.
+    if (untouched != Count) {
+      return blocks + untouched++;
+    }
+    return nullptr;
+  }
+
+  static void deallocate(void* const block) {
+    Block* const freed{static_cast<Block*>(block)};
+    freed->next = free_blocks;
+    free_blocks = freed;
+  }
+
+  //Every block has the same size, so it can be resized in place as long as the new size fits.
+  static bool try_extend(void*, size_t, const size_t new_bytes) {
+    return new_bytes <= BlockSize;
+  }
+
+  private:
+  //A free block stores the pointer to the next free block in its own memory.
+  union Block {
+    Block* next;
+    array_lib_internal::MaxAlign alignment;
+    unsigned char bytes[BlockSize];
+  };
+
+  static Block blocks[Count];
+  static Block* free_blocks;
+  static size_t untouched;
+};
+
+template <size_t BlockSize, size_t Count, typename Tag>
+typename PoolAllocator<BlockSize, Count, Tag>::Block PoolAllocator<BlockSize, Count, Tag>::blocks[Count];
+
+template <size_t BlockSize, size_t Count, typename Tag>
+typename PoolAllocator<BlockSize, Count, Tag>::Block* PoolAllocator<BlockSize, Count, Tag>::free_blocks{nullptr};
+
+template <size_t BlockSize, size_t Count, typename Tag>
+size_t PoolAllocator<BlockSize, Count, Tag>::untouched{0};
+
+//an allocator which never has any memory, for arrays which must not use the heap
+//An array which needs memory from it crashes the program.
+struct NoAllocator {
+  static void* allocate(size_t) {
+    return nullptr;
+  }
+
+  static void deallocate(void*) { }
+};
+
+namespace array_lib_internal {
+
+  //calls an allocator, fills in its optional functions and crashes the program when there is no memory left
+  template <typename Allocator>
+  struct Allocation {
+
+    static void* allocate(const size_t bytes) {
+      if (bytes == 0) {
+        return nullptr;
+      }
+      void* const block{Allocator::allocate(bytes)};
+      if (block == nullptr) {
+        abort();
+      }
+      return block;
+    }
+
+    static void deallocate(void* const block) {
+      if (block != nullptr) {
+        Allocator::deallocate(block);
+      }
+    }
+
+    //resizes the block without moving it or returns false
+    static bool try_extend(void* const block, const size_t old_bytes, const size_t new_bytes) {
+      return block != nullptr && new_bytes != 0 && try_extend<Allocator>(0, block, old_bytes, new_bytes);
+    }
+
+    //resizes a block whose contents may be moved with memcpy and returns where it is now
+    static void* resize(void* const block, const size_t old_bytes, const size_t new_bytes) {
+      if (block == nullptr) {
+        return allocate(new_bytes);
+      }
+      if (new_bytes == 0) {
+        Allocator::deallocate(block);
+        return nullptr;
+      }
+      if (try_extend(block, old_bytes, new_bytes)) {
+        return block;
+      }
+      void* const new_block{reallocate<Allocator>(0, block, old_bytes, new_bytes)};
+      if (new_block == nullptr) {
+        abort();
+      }
+      return new_block;
+    }
+
+    //gives back the end of a block whose contents may be moved with memcpy and returns where it is now
+    //Allocators which can't resize blocks keep them as they are, because copying to a smaller block would need more memory at first.
+    static void* shrink(void* const block, const size_t old_bytes, const size_t new_bytes) {
+      if (try_extend(block, old_bytes, new_bytes)) {
+        return block;
+      }
+      return shrink<Allocator>(0, block, old_bytes, new_bytes);
+    }
+
+    private:
+    //The int overloads are chosen if the allocator has the function, the long overloads otherwise.
+    template <typename A>
+    static auto try_extend(int, void* const block, const size_t old_bytes, const size_t new_bytes) -> decltype(A::try_extend(block, old_bytes, new_bytes)) {
+      return A::try_extend(block, old_bytes, new_bytes);
+    }
+
+    template <typename A>
+    static bool try_extend(long, void*, size_t, size_t) {
+      return false;
+    }
+
+    template <typename A>
+    static auto reallocate(int, void* const block, const size_t old_bytes, const size_t new_bytes) -> decltype(A::reallocate(block, old_bytes, new_bytes)) {
+      return A::reallocate(block, old_bytes, new_bytes);
+    }
+
+    template <typename A>
+    static auto shrink(int, void* const block, const size_t old_bytes, const size_t new_bytes) -> decltype(A::reallocate(block, old_bytes, new_bytes)) {
+      if (block == nullptr || new_bytes == 0) {
+        return block;
+      }
+      void* const new_block{A::reallocate(block, old_bytes, new_bytes)};
+      return new_block == nullptr ? block : new_block;
+    }
+
+    template <typename A>
+    static void* shrink(long, void* const block, size_t, size_t) {
+      return block;
+    }
+
+    template <typename A>
+    static void* reallocate(long, void* const block, const size_t old_bytes, const size_t new_bytes) {
+      void* const new_block{allocate(new_bytes)};
+      memcpy(new_block, block, old_bytes < new_bytes ? old_bytes : new_bytes);
+      A::deallocate(block);
+      return new_block;
+    }
+  };
+
+  //the alignment an allocator promises for its blocks, or 1 if it doesn't say
+  template <typename A>
+  constexpr auto declared_alignment(int) -> decltype(size_t{A::alignment}) {
+    return A::alignment;
+  }
+
+  template <typename A>
+  constexpr size_t declared_alignment(long) {
+    return 1;
+  }
+
+  template <typename A>
+  constexpr size_t allocator_alignment() {
+    return declared_alignment<A>(0);
+  }
+
+}
+
+//an allocator which aligns its blocks to Alignment bytes, so loops over the elements can use aligned vector instructions on a PC:
+//  HeapArray<float, AlignedAllocator<32>> samples{1024};
+//It gets the memory from the allocator in the second template parameter and asks it for Alignment bytes more for every block.
+//data() of the arrays tells the compiler about the alignment, and a SmallGrowingArray aligns its inline elements too.
+//Blocks can't be moved with realloc because that would lose the alignment, so growing arrays copy their elements into a new block instead.
+template <size_t Alignment, typename Allocator = MallocAllocator>
+struct AlignedAllocator {
+  static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0 && Alignment <= 128, "The alignment must be a power of two up to 128.");
+
+  static constexpr size_t alignment{Alignment};
+
+  static void* allocate(const size_t bytes) {
+    if (bytes > static_cast<size_t>(-1) - Alignment) {
+      return nullptr;
+    }
+    unsigned char* const block{static_cast<unsigned char*>(Allocator::allocate(bytes + Alignment))};
+    if (block == nullptr) {
+      return nullptr;
+    }
+    //There is always at least one byte of padding, and its last byte stores how many there are.
+    const size_t padding{Alignment - reinterpret_cast<size_t>(block) % Alignment};
+    block[padding - 1] = static_cast<unsigned char>(padding);
+    return block + padding;
+  }
+
+  static void deallocate(void* const block) {
+    Allocator::deallocate(start_of(block));
+  }
+
+  //The padding stays the same when the block is resized in place, so this works if the underlying allocator can do it, like an arena.
+  static bool try_extend(void* const block, const size_t old_bytes, const size_t new_bytes) {
+    return new_bytes <= static_cast<size_t>(-1) - Alignment
+      && array_lib_internal::Allocation<Allocator>::try_extend(start_of(block), old_bytes + Alignment, new_bytes + Alignment);
+  }
+
+  private:
+  static unsigned char* start_of(void* const block) {
+    unsigned char* const aligned{static_cast<unsigned char*>(block)};
+    return aligned - aligned[-1];
+  }
+};
+
+template <size_t Alignment, typename Allocator>
+constexpr size_t AlignedAllocator<Alignment, Allocator>::alignment;
+
+
+//a tag for constructing a HeapArray without initializing its elements: HeapArray<uint8_t> buffer{64, uninitialized};
+struct Uninitialized { };
+constexpr Uninitialized uninitialized{};
+
+//an array with a size which is known when the program runs and won't change
+//You can choose where its memory comes from with the second template parameter, see the allocators above.
+template <typename T, typename Allocator = MallocAllocator, typename Bounds = DefaultBounds>
+class HeapArray {
+
+  private:
+    //A HeapArray is internally a dynamic array with a stored size.
+    T* elements;
+    size_t size;
+
+    using Allocation = array_lib_internal::Allocation<Allocator>;
+
+  public:
+
+    //When constructing a HeapArray, you must provide its size.
+    //All elements are default initialized.
+    HeapArray(size_t length) : HeapArray{reinterpret_cast<T*>(Allocation::allocate(length * sizeof(T))), length} {
+      for (size_t i{0}; i != size; ++i) {
+        new (elements + i) T; //calling the default constructor explicitly at elements[i]
+      }
+    }
+
+    //doesn't initialize the elements at all, for buffers which you overwrite anyway, for example with data from a sensor
+    //Reading an element before writing it gives you garbage.
+    HeapArray(size_t length, Uninitialized) : HeapArray{reinterpret_cast<T*>(Allocation::allocate(length * sizeof(T))), length} {
+      static_assert(TriviallyCopyable<T>::value && TriviallyDestructible<T>::value, "only plain values can be left uninitialized");
+    }
+
+    //initializes all elements with copies of value, byte arrays with memset
+    HeapArray(size_t length, const T& value) : HeapArray{reinterpret_cast<T*>(Allocation::allocate(length * sizeof(T))), length} {
+      array_lib_internal::fill_construct(elements, size, value);
+    }
+
+    //initializes every element with what generator(index) returns: HeapArray<int> squares{10, [](size_t i) { return int(i * i); }};
+    template <typename Generator, typename = decltype((*static_cast<Generator*>(nullptr))(size_t{0}))>
+    HeapArray(size_t length, Generator generator) : HeapArray{reinterpret_cast<T*>(Allocation::allocate(length * sizeof(T))), length} {
+      for (size_t i{0}; i != size; ++i) {
+        new (elements + i) T(generator(i)); //calling the constructor with the generated value explicitly at elements[i]
+      }
+    }
+
+    HeapArray(HeapArray&& temp) : elements{temp.elements}, size{temp.size} {
+      temp.elements = nullptr;
+      temp.size = 0;
+    }
+
+    //You have to copy the HeapArray explicitly. That prevents you from accidentally passing it by value.
+    HeapArray(const HeapArray&) = delete;
+    HeapArray copy() const {
+      HeapArray result{reinterpret_cast<T*>(Allocation::allocate(size * sizeof(T))), size};
+      array_lib_internal::copy_construct(result.elements, elements, size);
+      return result;
+    }
+
+    //You can access the elements just like with C arrays.
+    //If the index is bigger than the array size, the program will crash unless the bounds checking policy says otherwise.
+    T& operator [] (const size_t index) {
+      if (Bounds::checks && index >= size) {
+        abort();
+      }
+      return elements[index];
+    }
+
+    const T& operator [] (const size_t index) const {
+      if (Bounds::checks && index >= size) {
+        abort();
+      }
+      return elements[index];
+    }
+
+    //like operator [], but always crashes the program if the index is bigger than the array size
+    T& at(const size_t index) {
+      if (index >= size) {
+        abort();
+      }
+      return elements[index];
+    }
+
+    const T& at(const size_t index) const {
+      if (index >= size) {
+        abort();
+      }
+      return elements[index];
+    }
+
+    //like operator [], but never checks the index, for loops where you know it is fine and every cycle counts
+    T& unchecked(const size_t index) {
+      return elements[index];
+    }
+
+    const T& unchecked(const size_t index) const {
+      return elements[index];
+    }
+
+    //You can loop over the elements like this: for (int& element : array) { ... }
+    //The iterators are plain pointers, so you can also pass them to anything which expects a pointer to the first and behind the last element.
+    T* begin() {
+      return elements;
+    }
+
+    const T* begin() const {
+      return elements;
+    }
+
+    T* end() {
+      return elements + size;
+    }
+
+    const T* end() const {
+      return elements + size;
+    }
+
+    //the pointer to the first element, for functions which take a C array
+    //If the allocator aligns its blocks, the compiler knows that the pointer is aligned.
+    T* data() {
+      return array_lib_internal::assume_aligned<array_lib_internal::allocator_alignment<Allocator>()>(elements);
+    }
+
+    const T* data() const {
+      return array_lib_internal::assume_aligned<array_lib_internal::allocator_alignment<Allocator>()>(elements);
+    }
+
+    //You can access the length.
+    size_t length() const {
+      return size;
+    }
+
+    //changes the length, which you should only need to do rarely, for example when a configuration changes
+    //New elements are default initialized, elements behind the new length are destroyed.
+    //The memory is resized in place if the allocator can do it. Otherwise trivially relocatable elements are moved with realloc or memcpy and other elements one by one.
+    //References you got by accessing an element might get invalidated.
+    void resize(const size_t length) {
+      if (length < size) {
+        array_lib_internal::destroy(elements + length, size - length);
+        if (length == 0) {
+          Allocation::deallocate(elements);
+          elements = nullptr;
+        } else {
+          shrink(length, array_lib_internal::BoolTag<TriviallyRelocatable<T>::value>{});
+        }
+        size = length;
+        return;
+      }
+      if (length > size) {
+        grow(length, array_lib_internal::BoolTag<TriviallyRelocatable<T>::value>{});
+        for (size_t i{size}; i != length; ++i) {
+          new (elements + i) T; //calling the default constructor explicitly at elements[i]
+        }
+        size = length;
+      }
+    }
+
+    ~HeapArray(){
+      array_lib_internal::destroy(elements, size);
+      Allocation::deallocate(elements);
+    }
+
+  private:
+    //takes over memory for length elements which are not constructed yet or which a GrowingArray has given up
+    HeapArray(T* const memory, const size_t length) : elements{memory}, size{length} { }
+
+    template <typename, typename, typename, size_t, typename>
+    friend class GrowingArray;
+
+    //The memory behind the elements is only given back if that doesn't need more memory at first.
+    void shrink(const size_t length, array_lib_internal::BoolTag<true>) {
+      elements = reinterpret_cast<T*>(Allocation::shrink(elements, size * sizeof(T), length * sizeof(T)));
+    }
+
+    void shrink(const size_t length, array_lib_internal::BoolTag<false>) {
+      Allocation::try_extend(elements, size * sizeof(T), length * sizeof(T));
+    }
+
+    void grow(const size_t length, array_lib_internal::BoolTag<true>) {
+      elements = reinterpret_cast<T*>(Allocation::resize(elements, size * sizeof(T), length * sizeof(T)));
+    }
+
+    void grow(const size_t length, array_lib_internal::BoolTag<false>) {
+      if (Allocation::try_extend(elements, size * sizeof(T), length * sizeof(T))) {
+        return;
+      }
+      auto memory = reinterpret_cast<T*>(Allocation::allocate(length * sizeof(T)));
+      for (size_t i{0}; i != size; ++i) {
+        new (memory + i) T(array_lib_internal::move(elements[i])); //calling the move constructor with elements[i] explicitly at memory[i]
+        elements[i].~T();
+      }
+      Allocation::deallocate(elements);
+      elements = memory;
+    }
+};
+
+
+//Growth policies decide how big a GrowingArray gets when it is full.
+//Growing by more wastes memory, growing by less means more reallocations.
+//You can also write your own, it just needs a function like these.
+
+//grows the capacity by half, which is the default because memory space on Arduinos is sparse
+struct GrowByHalf {
+  static size_t next_capacity(const size_t capacity) {
+    return ((capacity == 0 ? 1 : capacity) * 3 + 1) / 2;
+  }
+};
+
+//doubles the capacity, which is faster if you have plenty of memory, for example on a PC
+struct GrowByDoubling {
+  static size_t next_capacity(const size_t capacity) {
+    return (capacity == 0 ? 1 : capacity) * 2;
+  }
+};
+
+//adds Step elements at a time, which wastes at most Step - 1 elements but needs many reallocations for big arrays
+template <size_t Step>
+struct GrowByStep {
+  static_assert(Step != 0, "a GrowingArray can't grow by 0 elements");
+  static size_t next_capacity(const size_t capacity) {
+    return capacity + Step;
+  }
+};
+
+//grows to the next power of two, which suits allocators with blocks of these sizes
+struct GrowToPowerOfTwo {
+  static size_t next_capacity(const size_t capacity) {
+    size_t result{1};
+    while (result <= capacity) {
+      result *= 2;
+    }
+    return result;
+  }
+};
+
+
+//a growing array: You can push elements onto its end.
+//You can choose how it grows with the second template parameter, see the growth policies above.
+//You can choose where its memory comes from with the third template parameter, see the allocators above.
+//The last template parameter is the number of elements which fit into the array itself before it needs the heap, see SmallGrowingArray below.
+template <typename T, typename Growth = GrowByHalf, typename Allocator = MallocAllocator, size_t InlineCapacity = 0, typename Bounds = DefaultBounds>
+class GrowingArray : private array_lib_internal::InlineStorage<T, InlineCapacity, array_lib_internal::allocator_alignment<Allocator>()> {
+
+  private:
+    //A GrowingArray is internally allocated heap space.
+    //It is not reallocated for every new element, so we need to store how many elements fit into it.
+    T* elements;
+    size_t size;
+    size_t allocated;
+
+    using Allocation = array_lib_internal::Allocation<Allocator>;
+    using Relocatable = array_lib_internal::BoolTag<TriviallyRelocatable<T>::value>;
+
+
+  public:
+    //The default constructor creates an empty GrowingArray without allocating anything.
+    GrowingArray() : elements{this->inline_elements()}, size{0}, allocated{InlineCapacity} { }
+
+    //If you know how many elements you are going to push, you can allocate space for them right away.
+    explicit GrowingArray(const size_t capacity) : GrowingArray() {
+      reserve(capacity);
+    }
+
+    //creates a GrowingArray with copies of the elements of another array or view, which only allocates once
+    explicit GrowingArray(const ArrayView<const T> items) : GrowingArray() {
+      append(items);
+    }
+
+    GrowingArray(const T* const items, const size_t count) : GrowingArray() {
+      append(items, count);
+    }
+
+    GrowingArray(GrowingArray&& temp) : GrowingArray() {
+      if (temp.is_inline()) {
+        //Elements inside of the other array can't be taken over, they have to be moved one by one.
+        temp.move_elements(elements, Relocatable{});
+        size = temp.size;
+        temp.size = 0;
+        return;
+      }
+      elements = temp.elements;
+      size = temp.size;
+      allocated = temp.allocated;
+      temp.elements = temp.inline_elements();
+      temp.size = 0;
+      temp.allocated = InlineCapacity;
+    }
+    
+    //You have to copy the HeapArray explicitly. That prevents you from accidentally passing it by value.
+    GrowingArray(const GrowingArray&) = delete;
+    GrowingArray copy() const {
+      GrowingArray result;
+      result.reserve(size);
+      array_lib_internal::copy_construct(result.elements, elements, size);
+      result.size = size;
+      return result;
+    }
+
+    //You can access the elements just like with C arrays.
+    //If the index is bigger than the array size, the program will crash unless the bounds checking policy says otherwise.
+    T& operator [] (const size_t index) {
+      if (Bounds::checks && index >= size) {
+        abort();
+      }
+      return elements[index];
+    }
+
+    const T& operator [] (const size_t index) const {
+      if (Bounds::checks && index >= size) {
+        abort();
+      }
+      return elements[index];
+    }
+
+    //like operator [], but always crashes the program if the index is bigger than the array size
+    T& at(const size_t index) {
+      if (index >= size) {
+        abort();
+      }
+      return elements[index];
+    }
+
+    const T& at(const size_t index) const {
+      if (index >= size) {
+        abort();
+      }
+      return elements[index];
+    }
+
+    //like operator [], but never checks the index, for loops where you know it is fine and every cycle counts
+    T& unchecked(const size_t index) {
+      return elements[index];
+    }
+
+    const T& unchecked(const size_t index) const {
+      return elements[index];
+    }
+
+    //You can loop over the elements like this: for (int& element : array) { ... }
+    //The iterators are plain pointers, so you can also pass them to anything which expects a pointer to the first and behind the last element.
+    T* begin() {
+      return elements;
+    }
+
+    const T* begin() const {
+      return elements;
+    }
+
+    T* end() {
+      return elements + size;
+    }
+
+    const T* end() const {
+      return elements + size;
+    }
+
+    //the pointer to the first element, for functions which take a C array
+    //If the allocator aligns its blocks, the compiler knows that the pointer is aligned.
+    T* data() {
+      return array_lib_internal::assume_aligned<array_lib_internal::allocator_alignment<Allocator>()>(elements);
+    }
+
+    const T* data() const {
+      return array_lib_internal::assume_aligned<array_lib_internal::allocator_alignment<Allocator>()>(elements);
+    }
+
+    //pushes an item to the back of the array
+    //The item is copied. If you don't need it anymore, push a temporary or build it in place with emplace instead.
+    //The array might get reallocated, so references you got by accessing an element get invalidated.
+    void push(const T& item) {
+      if (size == allocated && contains(&item)) {
+        T copy(item); //the item would get invalidated by the reallocation
+        emplace(array_lib_internal::move(copy));
+        return;
+      }
+      emplace(item);
+    }
+
+    //pushes a temporary item to the back of the array by moving it, so for example a HeapArray is not copied
+    void push(T&& item) {
+      if (size == allocated && contains(&item)) {
+        T moved(array_lib_internal::move(item));
+        emplace(array_lib_internal::move(moved));
+        return;
+      }
+      emplace(array_lib_internal::move(item));
+    }
+
+    //constructs a new element at the back of the array directly from the constructor arguments and returns it
+    //Nothing is copied or moved, but the arguments must not refer to elements of this array.
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+      grow_for(size + 1);
+      new (elements + size) T(array_lib_internal::forward<Args>(args)...); //calling the constructor explicitly at elements[size]
+      return elements[size++];
+    }
+
+    //pushes copies of count items to the back of the array
+    //The array is reallocated at most once and trivially copyable items are copied with one memcpy, so this is much faster than pushing them one by one.
+    void append(const T* items, const size_t count) {
+      if (contains(items)) {
+        //The items would get invalidated by the reallocation.
+        const size_t offset{static_cast<size_t>(items - elements)};
+        grow_for(size + count);
+        items = elements + offset;
+      } else {
+        grow_for(size + count);
+      }
+      array_lib_internal::copy_construct(elements + size, items, count);
+      size += count;
+    }
+
+    //pushes copies of the elements of another array or view to the back of the array
+    void append(const ArrayView<const T> items) {
+      append(items.data(), items.length());
+    }
+
+    //removes the last element and returns it
+    //If the array is empty, the program will crash.
+    T pop() {
+      if (size == 0) {
+        abort();
+      }
+      --size;
+      T last(array_lib_internal::move(elements[size]));
+      elements[size].~T();
+      return last;
+    }
+
+    //inserts a copy of value in front of the element at index, which moves all elements behind it
+    //If index is bigger than the length, the program will crash.
+    void insert(const size_t index, const T& value) {
+      if (contains(&value)) {
+        T copy(value); //the value would get invalidated by moving the elements
+        insert(index, array_lib_internal::move(copy));
+        return;
+      }
+      open_gap(index);
+      new (elements + index) T(value); //calling the copy constructor with value explicitly at elements[index]
+      ++size;
+    }
+
+    void insert(const size_t index, T&& value) {
+      if (contains(&value)) {
+        T moved(array_lib_internal::move(value));
+        insert(index, array_lib_internal::move(moved));
+        return;
+      }
+      open_gap(index);
+      new (elements + index) T(array_lib_internal::move(value)); //calling the move constructor with value explicitly at elements[index]
+      ++size;
+    }
+
+    //removes the element at index and moves all elements behind it forward
+    //If there is no element at index, the program will crash.
+    void erase(const size_t index) {
+      erase(index, index + 1);
+    }
+
+    //removes the elements from first to before last and moves all elements behind them forward
+    //If the range is not inside of the array, the program will crash.
+    void erase(const size_t first, const size_t last) {
+      if (first > last || last > size) {
+        abort();
+      }
+      array_lib_internal::destroy(elements + first, last - first);
+      shift(last, first, size - last, Relocatable{});
+      size -= last - first;
+    }
+
+    //removes the element at index by moving the last element into its place, which doesn't keep the order but is much faster than erase
+    //If there is no element at index, the program will crash.
+    void swap_remove(const size_t index) {
+      if (index >= size) {
+        abort();
+      }
+      elements[index].~T();
+      --size;
+      if (index != size) {
+        shift(size, index, 1, Relocatable{});
+      }
+    }
+
+    //removes all elements but keeps the memory for new ones
+    void clear() {
+      array_lib_internal::destroy(elements, size);
+      size = 0;
+    }
+
+    //makes sure that at least capacity elements fit in without another reallocation
+    //It never shrinks the array. References you got by accessing an element get invalidated if it reallocates.
+    void reserve(const size_t capacity) {
+      if (capacity > allocated) {
+        reallocate(capacity);
+      }
+    }
+
+    //gives the memory which is not used by elements back to the heap
+    //If the elements fit into the array itself again, all the heap memory is given back.
+    //Use it when a long-lived array is done growing. References you got by accessing an element get invalidated.
+    void shrink_to_fit() {
+      if (size != allocated) {
+        reallocate(size);
+      }
+    }
+
+    //turns the GrowingArray into a HeapArray without copying the elements, which leaves it empty
+    //Use it when you are done filling an array and only want to read it from now on.
+    //By default, the memory which is not used by elements is given back first if that is possible without moving them, like with realloc.
+    //Elements which are stored inside of the array itself have to be moved to memory from the allocator.
+    HeapArray<T, Allocator, Bounds> freeze(const bool shrink = true) {
+      static_assert(!array_lib_internal::IsSame<Allocator, NoAllocator>::value, "an array without an allocator can't be frozen, because the HeapArray needs memory from it");
+      if (is_inline()) {
+        auto memory = reinterpret_cast<T*>(Allocation::allocate(size * sizeof(T)));
+        move_elements(memory, Relocatable{});
+        HeapArray<T, Allocator, Bounds> result{memory, size};
+        size = 0;
+        return result;
+      }
+      if (shrink && size != allocated) {
+        shrink_in_place(Relocatable{});
+      }
+      HeapArray<T, Allocator, Bounds> result{elements, size};
+      elements = this->inline_elements();
+      size = 0;
+      allocated = InlineCapacity;
+      return result;
+    }
+
+    //You can read the size but not change it directly.
+    size_t length() const {
+      return size;
+    }
+
+    //how many elements fit in before the array has to be reallocated
+    size_t capacity() const {
+      return allocated;
+    }
+
+    ~GrowingArray() {
+      clear();
+      if (!is_inline()) {
+        Allocation::deallocate(elements);
+      }
+    }
+
+  private:
+
+    //reallocates according to the growth policy if needed elements don't fit in
+    void grow_for(const size_t needed) {
+      if (needed > allocated) {
+        const size_t next{Growth::next_capacity(allocated)};
+        reallocate(next > needed ? next : needed);
+      }
+    }
+
+    void reallocate(const size_t new_capacity) {
+      if (new_capacity <= InlineCapacity) {
+        move_inline(array_lib_internal::BoolTag<InlineCapacity != 0>{});
+        return;
+      }
+      if (is_inline()) {
+        auto new_begin = reinterpret_cast<T*>(Allocation::allocate(new_capacity * sizeof(T)));
+        move_elements(new_begin, Relocatable{});
+        elements = new_begin;
+        allocated = new_capacity;
+        return;
+      }
+      reallocate(new_capacity, Relocatable{});
+    }
+
+    //moves the elements back into the array itself when they fit in there
+    void move_inline(array_lib_internal::BoolTag<true>) {
+      if (!is_inline()) {
+        move_elements(this->inline_elements(), Relocatable{});
+        Allocation::deallocate(elements);
+        elements = this->inline_elements();
+      }
+      allocated = InlineCapacity;
+    }
+
+    //Without inline storage, only an empty array is shrunk to capacity 0, so its block is just given back.
+    void move_inline(array_lib_internal::BoolTag<false>) {
+      Allocation::deallocate(elements);
+      elements = nullptr;
+      allocated = 0;
+    }
+
+    //Trivially relocatable elements are moved with the block, for example by realloc.
+    //It extends the block in place if there is free heap space behind it and falls back to malloc, memcpy and free otherwise.
+    void reallocate(const size_t new_capacity, array_lib_internal::BoolTag<true>) {
+      elements = reinterpret_cast<T*>(Allocation::resize(elements, allocated * sizeof(T), new_capacity * sizeof(T)));
+      allocated = new_capacity;
+    }
+
+    //All other elements are moved one by one into a new block if the allocator can't extend the old one in place.
+    void reallocate(const size_t new_capacity, array_lib_internal::BoolTag<false>) {
+      if (!Allocation::try_extend(elements, allocated * sizeof(T), new_capacity * sizeof(T))) {
+        auto new_begin = reinterpret_cast<T*>(Allocation::allocate(new_capacity * sizeof(T)));
+        move_elements(new_begin, Relocatable{});
+        Allocation::deallocate(elements);
+        elements = new_begin;
+      }
+      allocated = new_capacity;
+    }
+
+    //gives back the memory behind the elements before freezing if the allocator can do that without needing more memory first
+    //The capacity isn't updated because the array gives up the memory anyway.
+    void shrink_in_place(array_lib_internal::BoolTag<true>) {
+      elements = reinterpret_cast<T*>(Allocation::shrink(elements, allocated * sizeof(T), size * sizeof(T)));
+    }
+
+    void shrink_in_place(array_lib_internal::BoolTag<false>) {
+      Allocation::try_extend(elements, allocated * sizeof(T), size * sizeof(T));
+    }
+
+    //makes room for a new element at index, which isn't constructed yet
+    void open_gap(const size_t index) {
+      if (index > size) {
+        abort();
+      }
+      grow_for(size + 1);
+      shift(index, index + 1, size - index, Relocatable{});
+    }
+
+    //moves count elements starting at index from to uninitialized places starting at index to, which may overlap
+    //The old places are uninitialized afterwards, unless from and to are the same, then nothing happens.
+    void shift(const size_t from, const size_t to, const size_t count, array_lib_internal::BoolTag<true>) {
+      if (count != 0) {
+        memmove(elements + to, elements + from, count * sizeof(T));
+      }
+    }
+
+    void shift(const size_t from, const size_t to, const size_t count, array_lib_internal::BoolTag<false>) {
+      if (to < from) {
+        for (size_t i{0}; i != count; ++i) {
+          new (elements + to + i) T(array_lib_internal::move(elements[from + i])); //calling the move constructor explicitly at elements[to + i]
+          elements[from + i].~T();
+        }
+      } else if (to > from) {
+        for (size_t i{count}; i != 0; --i) {
+          new (elements + to + i - 1) T(array_lib_internal::move(elements[from + i - 1])); //calling the move constructor explicitly at elements[to + i - 1]
+          elements[from + i - 1].~T();
+        }
+      }
+    }
+
+    //moves the elements to uninitialized memory and leaves the old places uninitialized
+    void move_elements(T* const destination, array_lib_internal::BoolTag<true>) {
+      if (size != 0) {
+        memcpy(destination, elements, size * sizeof(T));
+      }
+    }
+
+    void move_elements(T* const destination, array_lib_internal::BoolTag<false>) {
+      for (size_t i{0}; i != size; ++i) {
+        new (destination + i) T(array_lib_internal::move(elements[i])); //calling the move constructor with elements[i] explicitly at destination[i]
+        elements[i].~T();
+      }
+    }
+
+    //whether the elements are stored inside of the array itself
+    bool is_inline() {
+      return InlineCapacity != 0 && elements == this->inline_elements();
+    }
+
+    //whether the pointer points to one of the elements
+    bool contains(const T* const pointer) {
+      return size != 0 && pointer >= elements && pointer < elements + size;
+    }
+};
+
+//a GrowingArray which stores up to N elements inside of itself and only uses the heap for more
+//Most arrays which never get bigger than a few elements then never allocate anything.
+//Moving it moves the elements one by one while they are stored inside, so it is not a good idea to make N huge.
+template <typename T, size_t N, typename Growth = GrowByHalf, typename Allocator = MallocAllocator, typename Bounds = DefaultBounds>
+using SmallGrowingArray = GrowingArray<T, Growth, Allocator, N, Bounds>;
+
+//an array with space for N elements on the stack which you can push elements onto and pop them from
+//It never uses the heap, so it can be used where that is forbidden, for example close to interrupts.
+//Pushing more than N elements will crash the program, and so will reserve() with more than N.
+//shrink_to_fit() does nothing, and freeze() doesn't compile because there is no memory for the HeapArray.
+template <typename T, size_t N, typename Bounds = DefaultBounds>
+using StaticVector = GrowingArray<T, GrowByHalf, NoAllocator, N, Bounds>;
+
+namespace array_lib_internal {
+
+  //Indices of a RingBuffer must be read and written in one instruction, so small buffers use bytes, which works on 8 bit boards too.
+  template <bool Small> struct RingIndex        {using type = size_t;};
+  template <>           struct RingIndex<true>  {using type = unsigned char;};
+
+  //reads a variable which is written by the other side of a RingBuffer
+  //Everything the other side wrote before the variable is visible after reading it.
+  template <typename T>
+  inline T load_acquire(const volatile T& variable) {
+#if defined(__AVR__)
+    //There is only one core, so it is enough to keep the compiler from reordering.
+    const T value{variable};
+    asm volatile("" ::: "memory");
+    return value;
+#else
+    return __atomic_load_n(&variable, __ATOMIC_ACQUIRE);
+#endif
+  }
+
+  //writes a variable which is read by the other side of a RingBuffer after everything written before
+  template <typename T>
+  inline void store_release(volatile T& variable, const T value) {
+#if defined(__AVR__)
+    asm volatile("" ::: "memory");
+    variable = value;
+#else
+    __atomic_store_n(&variable, value, __ATOMIC_RELEASE);
+#endif
+  }
+
+}
+
+//a queue of up to N elements in a StackArray for passing data from one producer to one consumer, for example from an interrupt to loop()
+//Pushing and popping never disable interrupts and never block. Only one side may push and only one side may pop.
+//N must be a power of two, and on 8 bit boards at most 128.
+template <typename T, size_t N>
+class RingBuffer {
+
+  static_assert(N != 0 && (N & (N - 1)) == 0, "the capacity of a RingBuffer must be a power of two");
+#if defined(__AVR__)
+  static_assert(N <= 128, "the indices of a RingBuffer must fit into a byte on 8 bit boards");
+#endif
+
+  private:
+    using Index = typename array_lib_internal::RingIndex<(N <= 128)>::type;
+
+    //The indices count up forever and wrap around on their own, the element for an index is at index & (N - 1).
+    //Only the producer writes head and only the consumer writes tail.
+    StackArray<T, N> elements;
+    volatile Index head;
+    volatile Index tail;
+
+  public:
+    RingBuffer() : head{0}, tail{0} { }
+
+    RingBuffer(const RingBuffer&) = delete;
+
+    //adds an item at the end if there is space and returns whether it did
+    //Only call it from the producer.
+    bool push(const T& item) {
+      const Index write{head};
+      if (static_cast<Index>(write - array_lib_internal::load_acquire(tail)) == N) {
+        return false;
+      }
+      elements.c_array[write & (N - 1)] = item;
+      array_lib_internal::store_release(head, static_cast<Index>(write + 1));
+      return true;
+    }
+
+    //takes the item at the front into item if there is one and returns whether it did
+    //Only call it from the consumer.
+    bool pop(T& item) {
+      const Index read{tail};
+      if (array_lib_internal::load_acquire(head) == read) {
+        return false;
+      }
+      item = array_lib_internal::move(elements.c_array[read & (N - 1)]);
+      array_lib_internal::store_release(tail, static_cast<Index>(read + 1));
+      return true;
+    }
+
+    //adds as many of the count items as there is space for and returns how many that were
+    //The items are copied in at most two contiguous pieces. Only call it from the producer.
+    size_t push_n(const T* const items, const size_t count) {
+      const Index write{head};
+      const size_t space{N - static_cast<Index>(write - array_lib_internal::load_acquire(tail))};
+      const size_t pushed{count < space ? count : space};
+      const size_t start{write & (N - 1)};
+      const size_t before_wrap{pushed < N - start ? pushed : N - start};
+      copy(items, items + before_wrap, elements.c_array + start);
+      copy(items + before_wrap, items + pushed, elements.c_array);
+      array_lib_internal::store_release(head, static_cast<Index>(write + pushed));
+      return pushed;
+    }
+
+    //takes up to count items from the front into items and returns how many that were
+    //The items are copied out in at most two contiguous pieces. Only call it from the consumer.
+    size_t pop_n(T* const items, const size_t count) {
+      const Index read{tail};
+      const size_t available{static_cast<Index>(array_lib_internal::load_acquire(head) - read)};
+      const size_t popped{count < available ? count : available};
+      const size_t start{read & (N - 1)};
+      const size_t before_wrap{popped < N - start ? popped : N - start};
+      copy(elements.c_array + start, elements.c_array + start + before_wrap, items);
+      copy(elements.c_array, elements.c_array + popped - before_wrap, items + before_wrap);
+      array_lib_internal::store_release(tail, static_cast<Index>(read + popped));
+      return popped;
+    }
+
+    //how many items are in the buffer right now
+    //If the other side is busy, this might already be outdated when you get it.
+    size_t length() const {
+      return static_cast<Index>(array_lib_internal::load_acquire(head) - array_lib_internal::load_acquire(tail));
+    }
+
+    //You can access the capacity before and when the program runs.
+    constexpr size_t capacity() const {
+      return N;
+    }
+
+  private:
+    static void copy(const T* const from, const T* const end, T* const to) {
+      copy(from, end, to, array_lib_internal::BoolTag<TriviallyCopyable<T>::value>{});
+    }
+
+    static void copy(const T* const from, const T* const end, T* const to, array_lib_internal::BoolTag<true>) {
+      if (from != end) {
+        memcpy(to, from, (end - from) * sizeof(T));
+      }
+    }
+
+    static void copy(const T* from, const T* const end, T* to, array_lib_internal::BoolTag<false>) {
+      while (from != end) {
+        *to++ = *from++;
+      }
+    }
+};
+
+namespace array_lib_internal {
+
+  //is only a valid type if an array of U can be used as an array of T, which means that T is U or const U
+  //The types are compared instead of checking whether U* converts to T*, because a Derived* converts to a Base* although the elements have different sizes.
+  //ArrayView uses it so that overloads for views of different types don't make calls with arrays ambiguous.
+  template <typename U, typename T>
+  using ConvertibleElements = typename EnableIf<IsSame<U, T>::value || IsSame<const U, T>::value>::type;
+
+  //stores the length of an ArrayView, or nothing if it is known before the program runs
+  template <size_t Extent>
+  struct ViewLength {
+    constexpr ViewLength(size_t) { }
+
+    constexpr size_t get() const {
+      return Extent;
+    }
+  };
+
+  template <>
+  struct ViewLength<DynamicExtent> {
+    constexpr ViewLength(const size_t length) : length{length} { }
+
+    constexpr size_t get() const {
+      return length;
+    }
+
+    size_t length;
+  };
+
+}
+
+//a view of elements which are stored somewhere else: in a StackArray, a HeapArray, a GrowingArray, a C array or another view
+//It is just a pointer and a length, so you can pass it by value to hand a part of an array to a function without copying anything:
+//  uint8_t checksum(ArrayView<const uint8_t> bytes);
+//  ...
+//  checksum(message.subview(2, 16));
+//The view doesn't own the elements, so it must not outlive the array it views. Use ArrayView<const T> if the elements shouldn't be changed.
+//If you know the length before the program runs, you can give it as the second template parameter to save storing it.
+template <typename T, size_t Extent, typename Bounds>
+class ArrayView : private array_lib_internal::ViewLength<Extent> {
+
+  private:
+    T* elements;
+
+    using ViewLength = array_lib_internal::ViewLength<Extent>;
+
+  public:
+    //views length elements starting at pointer
+    //If the view has a fixed extent and length is different, the program will crash.
+    constexpr ArrayView(T* const pointer, const size_t length) : ViewLength{length}, elements{checked(pointer, length)} { }
+
+    template <size_t N>
+    constexpr ArrayView(T (&c_array)[N]) : ViewLength{N}, elements{c_array} {
+      static_assert(Extent == DynamicExtent || Extent == N, "the C array doesn't have the length of the view");
+    }
+
+    template <typename U, size_t N, typename B, typename = array_lib_internal::ConvertibleElements<U, T>>
+    constexpr ArrayView(StackArray<U, N, B>& array) : ViewLength{N}, elements{array.c_array} {
+      static_assert(Extent == DynamicExtent || Extent == N, "the StackArray doesn't have the length of the view");
+    }
+
+    template <typename U, size_t N, typename B, typename = array_lib_internal::ConvertibleElements<const U, T>>
+    constexpr ArrayView(const StackArray<U, N, B>& array) : ViewLength{N}, elements{array.c_array} {
+      static_assert(Extent == DynamicExtent || Extent == N, "the StackArray doesn't have the length of the view");
+    }
+
+    template <typename U, typename A, typename B, typename = array_lib_internal::ConvertibleElements<U, T>>
+    ArrayView(HeapArray<U, A, B>& array) : ArrayView{array.data(), array.length()} { }
+
+    template <typename U, typename A, typename B, typename = array_lib_internal::ConvertibleElements<const U, T>>
+    ArrayView(const HeapArray<U, A, B>& array) : ArrayView{array.data(), array.length()} { }
+
+    template <typename U, typename G, typename A, size_t N, typename B, typename = array_lib_internal::ConvertibleElements<U, T>>
+    ArrayView(GrowingArray<U, G, A, N, B>& array) : ArrayView{array.data(), array.length()} { }
+
+    template <typename U, typename G, typename A, size_t N, typename B, typename = array_lib_internal::ConvertibleElements<const U, T>>
+    ArrayView(const GrowingArray<U, G, A, N, B>& array) : ArrayView{array.data(), array.length()} { }
+
+    //A view of U can become a view of const U, and a view with a fixed extent can become one without.
+    template <typename U, size_t E, typename B, typename = array_lib_internal::ConvertibleElements<U, T>>
+    constexpr ArrayView(const ArrayView<U, E, B>& view) : ViewLength{view.length()}, elements{checked(view.data(), view.length())} {
+      static_assert(Extent == DynamicExtent || E == DynamicExtent || Extent == E, "the views have different lengths");
+    }
+
+    //You can access the elements just like with C arrays.
+    //If the index is bigger than the view length, the program will crash unless the bounds checking policy says otherwise.
+    constexpr T& operator [] (const size_t index) const {
+      return (!Bounds::checks || index < length()) ? elements[index] : *out_of_bounds();
+    }
+
+    //like operator [], but always crashes the program if the index is bigger than the view length
+    constexpr T& at(const size_t index) const {
+      return (index < length()) ? elements[index] : *out_of_bounds();
+    }
+
+    //like operator [], but never checks the index, for loops where you know it is fine and every cycle counts
+    constexpr T& unchecked(const size_t index) const {
+      return elements[index];
+    }
+
+    //You can loop over the elements like this: for (int& element : view) { ... }
+    constexpr T* begin() const {
+      return elements;
+    }
+
+    constexpr T* end() const {
+      return elements + length();
+    }
+
+    constexpr T* data() const {
+      return elements;
+    }
+
+    constexpr size_t length() const {
+      return ViewLength::get();
+    }
+
+    //views count elements starting at offset
+    //If they are not all in this view, the program will crash.
+    ArrayView<T, DynamicExtent, Bounds> subview(const size_t offset, const size_t count) const {
+      if (offset > length() || count > length() - offset) {
+        abort();
+      }
+      return {elements + offset, count};
+    }
+
+    //views the first count elements
+    ArrayView<T, DynamicExtent, Bounds> first(const size_t count) const {
+      return subview(0, count);
+    }
+
+    //views the last count elements
+    ArrayView<T, DynamicExtent, Bounds> last(const size_t count) const {
+      if (count > length()) {
+        abort();
+      }
+      return {elements + length() - count, count};
+    }
+
+    //You can also give the count as a template parameter to get a view with a fixed extent: view.first<4>()
+    template <size_t Count>
+    ArrayView<T, Count, Bounds> first() const {
+      return {first(Count).data(), Count};
+    }
+
+    template <size_t Count>
+    ArrayView<T, Count, Bounds> last() const {
+      return {last(Count).data(), Count};
+    }
+
+  private:
+    //just helper functions to crash the program when the arguments are wrong, also before the program runs
+    static constexpr T* checked(T* const pointer, const size_t length) {
+      return (Extent == DynamicExtent || length == Extent) ? pointer : out_of_bounds();
+    }
+
+    static inline T* out_of_bounds() {
+      abort();
+      return nullptr; //never called
+    }
+};
+
+namespace array_lib_internal {
+
+  //asks the CPU to load memory into the cache which will be read soon
+  inline void prefetch(const void* const address) {
+#if defined(__GNUC__)
+    __builtin_prefetch(address);
+#else
+    (void) address;
+#endif
+  }
+
+}
+
+//Search layouts decide how a SortedIndex stores the elements.
+
+//stores the sorted elements like a binary search tree in breadth first order, see eytzinger above
+//The first levels of the tree share a few cache lines, and the search prefetches the first of the nodes four levels ahead.
+//A SortedIndex aligns the layout to 64 byte cache lines, so for elements of up to 4 bytes, all 16 of those nodes are in the prefetched line.
+struct EytzingerLayout {
+
+  //Node k is stored at index k, index 0 is not used.
+  static size_t slots(const size_t n) {
+    return n + 1;
+  }
+
+  template <typename T>
+  static void build(const T* const sorted, const size_t n, T* const layout) {
+    build(sorted, n, layout, 1, 0);
+  }
+
+  template <typename T>
+  static const T* lower_bound(const T* const layout, const size_t n, const T& value) {
+    size_t k{1};
+    while (k <= n) {
+      //the descendants four levels down from node k are the nodes 16k to 16k + 15
+      array_lib_internal::prefetch(layout + 16 * k);
+      k = 2 * k + (layout[k] < value);
+    }
+    //The answer is the node where the search went left the last time, so the right turns after it are removed.
+    while (k % 2 == 1) {
+      k /= 2;
+    }
+    k /= 2;
+    return k == 0 ? nullptr : layout + k;
+  }
+
+  //the index in the sorted order of the element at node k
+  //In a full tree of height h, the node with index q on level d has (2q + 1) * 2^(h - d - 1) - 1 elements before it.
+  //The last level is only filled from the left, so the nodes missing there are subtracted.
+  static size_t rank(const size_t k, const size_t n) {
+    size_t depth{0};
+    while (k >> (depth + 1) != 0) {
+      ++depth;
+    }
+    size_t height{0};
+    while (n >> height != 0) {
+      ++height;
+    }
+    const size_t position{((2 * (k - (size_t{1} << depth)) + 1) << (height - depth - 1)) - 1};
+    const size_t leaves{n - ((size_t{1} << (height - 1)) - 1)};
+    const size_t leaves_before{(position + 1) / 2};
+    return leaves_before > leaves ? position - (leaves_before - leaves) : position;
+  }
+
+  private:
+  //fills the subtree of node k in order and returns the index of the next sorted element
+  template <typename T>
+  static size_t build(const T* const sorted, const size_t n, T* const layout, const size_t k, size_t i) {
+    if (k <= n) {
+      i = build(sorted, n, layout, 2 * k, i);
+      layout[k] = sorted[i++];
+      i = build(sorted, n, layout, 2 * k + 1, i);
+    }
+    return i;
+  }
+};
+
+//stores the sorted elements like a B-tree whose nodes are blocks of B elements, with B + 1 children each
+//A search reads one block per level, which takes just log(n) / log(B + 1) cache misses if a block fills a cache line, for example 16 elements of 4 bytes.
+//Comparing to all elements of a block at once has no branches the CPU can mispredict, and the compiler can vectorize it.
+template <size_t B = 16>
+struct BlockedLayout {
+
+  static_assert(B != 0, "the blocks of a BlockedLayout can't be empty");
+
+  //The slots left over after the n elements are filled with copies of the biggest element.
+  //They are the last places in sorted order, which can also be in inner blocks of the tree, not only in the last block.
+  static size_t slots(const size_t n) {
+    return blocks(n) * B;
+  }
+
+  template <typename T>
+  static void build(const T* const sorted, const size_t n, T* const layout) {
+    if (n != 0) {
+      build(sorted, n, layout, 0, 0);
+    }
+  }
+
+  template <typename T>
+  static const T* lower_bound(const T* const layout, const size_t n, const T& value) {
+    const size_t block_count{blocks(n)};
+    const T* result{nullptr};
+    size_t k{0};
+    while (k < block_count) {
+      const T* const block{layout + k * B};
+      size_t smaller{0};
+      for (size_t i{0}; i != B; ++i) {
+        smaller += block[i] < value;
+      }
+      if (smaller != B) {
+        result = block + smaller;
+      }
+      k = child(k, smaller);
+    }
+    return result;
+  }
+
+  //the index in the sorted order of the element in slot i
+  //In a full tree of height h, element j of the block with index q on level d has q * (B + 1)^(h - d) + (j + 1) * (B + 1)^(h - d - 1) - 1 elements before it.
+  //The last level is only filled from the left, so the elements of the blocks missing there are subtracted.
+  static size_t rank(const size_t i, const size_t n) {
+    const size_t k{i / B};
+    size_t depth{0};
+    size_t level_start{0};
+    size_t level_width{1};
+    while (k >= level_start + level_width) {
+      level_start += level_width;
+      level_width *= B + 1;
+      ++depth;
+    }
+    size_t below{1};
+    size_t full_blocks{level_start + level_width};
+    size_t last_level_start{level_start};
+    for (size_t width{level_width * (B + 1)}; full_blocks < blocks(n); width *= B + 1) {
+      last_level_start = full_blocks;
+      full_blocks += width;
+      below *= B + 1;
+    }
+    const size_t position{(k - level_start) * below * (B + 1) + (i % B + 1) * below - 1};
+    const size_t leaves{blocks(n) - last_level_start};
+    const size_t leaves_before{(position + 1) / (B + 1)};
+    return leaves_before > leaves ? position - (leaves_before - leaves) * B : position;
+  }
+
+  private:
+  static size_t blocks(const size_t n) {
+    return (n + B - 1) / B;
+  }
+
+  static size_t child(const size_t k, const size_t i) {
+    return k * (B + 1) + i + 1;
+  }
+
+  //fills the subtree of block k in order and returns the index of the next sorted element
+  template <typename T>
+  static size_t build(const T* const sorted, const size_t n, T* const layout, const size_t k, size_t i) {
+    if (k < blocks(n)) {
+      for (size_t j{0}; j != B; ++j) {
+        i = build(sorted, n, layout, child(k, j), i);
+        layout[k * B + j] = i < n ? sorted[i] : sorted[n - 1];
+        ++i;
+      }
+      i = build(sorted, n, layout, child(k, B), i);
+    }
+    return i;
+  }
+};
+
+//a copy of a sorted array in a layout which can be searched faster than with binary search, especially when the array is much bigger than the cache
+//  SortedIndex<uint32_t> index{ids};
+//  const uint32_t* id{index.lower_bound(42)};
+//The elements must be plain values which can be compared with <. You can choose the layout and where the memory comes from with the template parameters.
+//The layout is aligned to 64 byte cache lines, which costs up to 64 bytes more memory.
+template <typename T, typename Layout = EytzingerLayout, typename Allocator = MallocAllocator>
+class SortedIndex {
+
+  static_assert(TriviallyCopyable<T>::value, "a SortedIndex can only store plain values");
+
+  private:
+    HeapArray<T, AlignedAllocator<64, Allocator>> layout;
+    size_t size;
+
+  public:
+    //copies the elements of a sorted array or view into the layout
+    explicit SortedIndex(const ArrayView<const T> sorted) : layout{Layout::slots(sorted.length()), uninitialized}, size{sorted.length()} {
+      Layout::build(sorted.data(), size, layout.data());
+    }
+
+    //returns a pointer to the smallest element which is not smaller than value, or nullptr if there is none
+    const T* lower_bound(const T& value) const {
+      return Layout::lower_bound(layout.data(), size, value);
+    }
+
+    //returns the index in the sorted array of the smallest element which is not smaller than value, or length() if there is none
+    //Data which belongs to the elements can be stored in another array in the same order and found with it:
+    //  const size_t i{index.rank(42)};
+    //  if (i != index.length() && ids[i] == 42) { ... names[i] ... }
+    size_t rank(const T& value) const {
+      const T* const found{lower_bound(value)};
+      return found == nullptr ? size : Layout::rank(found - layout.data(), size);
+    }
+
+    //returns whether one of the elements is equal to value
+    bool contains(const T& value) const {
+      const T* const found{lower_bound(value)};
+      return found != nullptr && !(value < *found);
+    }
+
+    size_t length() const {
+      return size;
     }
 };
 
@@ -0,0 +1,607 @@
+/*
+ * array_lib_algorithms.h - Fast kernels for sample buffers in the arrays of array_lib.h: sum, dot product, minimum and maximum, scaling, clamping and histograms.
+ * On x86 PCs, they use SSE2 or AVX2, whichever the processor has. On all other boards, they are plain loops.
+ * No license, please use this code however you want. No guarantees too, though.
+ */
+
+#ifndef TIMON_PASSLICK_ARRAY_LIB_ALGORITHMS
+#define TIMON_PASSLICK_ARRAY_LIB_ALGORITHMS
+
+#include "array_lib.h"
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ARRAY_LIB_X86_SIMD
+#include <immintrin.h>
+#endif
+
+//All kernels take views, so you can pass any array or a part of it: sum(samples), sum(samples.last(64))
+//They read and write the elements directly instead of through operator [], so there are no bounds checks in the loops.
+
+//the smallest and the biggest element of an array
+template <typename T>
+struct MinMax {
+  T smallest;
+  T biggest;
+};
+
+namespace array_lib_internal {
+
+  //which instructions the processor has, so the kernels can choose the fastest version when the program runs
+  enum class SimdLevel { scalar, sse2, avx2 };
+
+  inline SimdLevel simd_level() {
+#ifdef ARRAY_LIB_X86_SIMD
+    static const SimdLevel level{[]() {
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") ? SimdLevel::avx2
+        : __builtin_cpu_supports("sse2") ? SimdLevel::sse2
+        : SimdLevel::scalar;
+    }()};
+    return level;
+#else
+    return SimdLevel::scalar;
+#endif
+  }
+
+  //The plain loops are the versions for all boards and handle the elements which don't fill a whole vector.
+
+  inline float sum_scalar(const float* const samples, const size_t count) {
+    float result{0};
+    for (size_t i{0}; i != count; ++i) {
+      result += samples[i];
+    }
+    return result;
+  }
+
+  inline int64_t sum_scalar(const int16_t* const samples, const size_t count) {
+    int64_t result{0};
+    for (size_t i{0}; i != count; ++i) {
+      result += samples[i];
+    }
+    return result;
+  }
+
+  inline float dot_scalar(const float* const first, const float* const second, const size_t count) {
+    float result{0};
+    for (size_t i{0}; i != count; ++i) {
+      result += first[i] * second[i];
+    }
+    return result;
+  }
+
+  inline int64_t dot_scalar(const int16_t* const first, const int16_t* const second, const size_t count) {
+    int64_t result{0};
+    for (size_t i{0}; i != count; ++i) {
+      result += int32_t{first[i]} * second[i];
+    }
+    return result;
+  }
+
+  template <typename T>
+  inline void min_max_scalar(const T* const samples, const size_t count, MinMax<T>& result) {
+    for (size_t i{0}; i != count; ++i) {
+      if (samples[i] < result.smallest) {
+        result.smallest = samples[i];
+      }
+      if (samples[i] > result.biggest) {
+        result.biggest = samples[i];
+      }
+    }
+  }
+
+  inline void scale_scalar(float* const samples, const size_t count, const float factor) {
+    for (size_t i{0}; i != count; ++i) {
+      samples[i] *= factor;
+    }
+  }
+
+  inline void scale_scalar(int16_t* const samples, const size_t count, const int16_t factor) {
+    for (size_t i{0}; i != count; ++i) {
+      const int32_t product{int32_t{samples[i]} * factor};
+      samples[i] = product > INT16_MAX ? INT16_MAX : product < INT16_MIN ? INT16_MIN : static_cast<int16_t>(product);
+    }
+  }
+
+  template <typename T>
+  inline void clamp_scalar(T* const samples, const size_t count, const T lowest, const T highest) {
+    for (size_t i{0}; i != count; ++i) {
+      samples[i] = samples[i] < lowest ? lowest : samples[i] > highest ? highest : samples[i];
+    }
+  }
+
+#ifdef ARRAY_LIB_X86_SIMD
+
+  //The vector versions process as many elements as fill whole vectors and return how many that were, the rest is done by the plain loops.
+  //They use unaligned loads, so the buffers don't need to be aligned, but aligned buffers are faster.
+
+  __attribute__((target("sse2")))
+  inline size_t sum_sse2(const float* const samples, const size_t count, float& result) {
+    __m128 sums[4]{_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+    size_t i{0};
+    for (; i + 16 <= count; i += 16) {
+      for (size_t j{0}; j != 4; ++j) {
+        sums[j] = _mm_add_ps(sums[j], _mm_loadu_ps(samples + i + 4 * j));
+      }
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, _mm_add_ps(_mm_add_ps(sums[0], sums[1]), _mm_add_ps(sums[2], sums[3])));
+    result = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    return i;
+  }
+
+  __attribute__((target("avx2")))
+  inline size_t sum_avx2(const float* const samples, const size_t count, float& result) {
+    __m256 sums[4]{_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps()};
+    size_t i{0};
+    for (; i + 32 <= count; i += 32) {
+      for (size_t j{0}; j != 4; ++j) {
+        sums[j] = _mm256_add_ps(sums[j], _mm256_loadu_ps(samples + i + 8 * j));
+      }
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, _mm256_add_ps(_mm256_add_ps(sums[0], sums[1]), _mm256_add_ps(sums[2], sums[3])));
+    result = lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+    return i;
+  }
+
+  //Pairs of samples are added to 32 bit sums, which are added to the 64 bit result before they can overflow.
+  __attribute__((target("sse2")))
+  inline size_t sum_sse2(const int16_t* const samples, const size_t count, int64_t& result) {
+    const __m128i ones{_mm_set1_epi16(1)};
+    size_t i{0};
+    while (i + 8 <= count) {
+      __m128i sums{_mm_setzero_si128()};
+      for (size_t steps{0}; steps != 16384 && i + 8 <= count; ++steps, i += 8) {
+        sums = _mm_add_epi32(sums, _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i)), ones));
+      }
+      int32_t lanes[4];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sums);
+      result += int64_t{lanes[0]} + lanes[1] + lanes[2] + lanes[3];
+    }
+    return i;
+  }
+
+  __attribute__((target("avx2")))
+  inline size_t sum_avx2(const int16_t* const samples, const size_t count, int64_t& result) {
+    const __m256i ones{_mm256_set1_epi16(1)};
+    size_t i{0};
+    while (i + 16 <= count) {
+      __m256i sums{_mm256_setzero_si256()};
+      for (size_t steps{0}; steps != 16384 && i + 16 <= count; ++steps, i += 16) {
+        sums = _mm256_add_epi32(sums, _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples + i)), ones));
+      }
+      int32_t lanes[8];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), sums);
+      result += int64_t{lanes[0]} + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+    }
+    return i;
+  }
+
+  __attribute__((target("sse2")))
+  inline size_t dot_sse2(const float* const first, const float* const second, const size_t count, float& result) {
+    __m128 sums[4]{_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+    size_t i{0};
+    for (; i + 16 <= count; i += 16) {
+      for (size_t j{0}; j != 4; ++j) {
+        sums[j] = _mm_add_ps(sums[j], _mm_mul_ps(_mm_loadu_ps(first + i + 4 * j), _mm_loadu_ps(second + i + 4 * j)));
+      }
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, _mm_add_ps(_mm_add_ps(sums[0], sums[1]), _mm_add_ps(sums[2], sums[3])));
+    result = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    return i;
+  }
+
+  __attribute__((target("avx2")))
+  inline size_t dot_avx2(const float* const first, const float* const second, const size_t count, float& result) {
+    __m256 sums[4]{_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps()};
+    size_t i{0};
+    for (; i + 32 <= count; i += 32) {
+      for (size_t j{0}; j != 4; ++j) {
+        sums[j] = _mm256_add_ps(sums[j], _mm256_mul_ps(_mm256_loadu_ps(first + i + 8 * j), _mm256_loadu_ps(second + i + 8 * j)));
+      }
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, _mm256_add_ps(_mm256_add_ps(sums[0], sums[1]), _mm256_add_ps(sums[2], sums[3])));
+    result = lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+    return i;
+  }
+
+  //_mm_madd_epi16 adds two products to a 32 bit sum. The only sum which doesn't fit is 2 * -32768 * -32768 = 2^31, which wraps to -2^31.
+  //No other sum can be -2^31, so when widening to 64 bits, the upper half of -2^31 is 0 instead of -1.
+  __attribute__((target("sse2")))
+  inline __m128i add_widened_sse2(const __m128i sums, const __m128i pairs) {
+    const __m128i upper{_mm_xor_si128(_mm_srai_epi32(pairs, 31), _mm_cmpeq_epi32(pairs, _mm_set1_epi32(INT32_MIN)))};
+    return _mm_add_epi64(_mm_add_epi64(sums, _mm_unpacklo_epi32(pairs, upper)), _mm_unpackhi_epi32(pairs, upper));
+  }
+
+  __attribute__((target("avx2")))
+  inline __m256i add_widened_avx2(const __m256i sums, const __m256i pairs) {
+    const __m256i upper{_mm256_xor_si256(_mm256_srai_epi32(pairs, 31), _mm256_cmpeq_epi32(pairs, _mm256_set1_epi32(INT32_MIN)))};
+    return _mm256_add_epi64(_mm256_add_epi64(sums, _mm256_unpacklo_epi32(pairs, upper)), _mm256_unpackhi_epi32(pairs, upper));
+  }
+
+  __attribute__((target("sse2")))
+  inline size_t dot_sse2(const int16_t* const first, const int16_t* const second, const size_t count, int64_t& result) {
+    __m128i sums{_mm_setzero_si128()};
+    size_t i{0};
+    for (; i + 8 <= count; i += 8) {
+      const __m128i pairs{_mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i)))};
+      sums = add_widened_sse2(sums, pairs);
+    }
+    int64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sums);
+    result = lanes[0] + lanes[1];
+    return i;
+  }
+
+  __attribute__((target("avx2")))
+  inline size_t dot_avx2(const int16_t* const first, const int16_t* const second, const size_t count, int64_t& result) {
+    __m256i sums{_mm256_setzero_si256()};
+    size_t i{0};
+    for (; i + 16 <= count; i += 16) {
+      const __m256i pairs{_mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i)))};
+      sums = add_widened_avx2(sums, pairs);
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), sums);
+    result = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    return i;
+  }
+
+  __attribute__((target("sse2")))
+  inline size_t min_max_sse2(const float* const samples, const size_t count, MinMax<float>& result) {
+    __m128 smallest{_mm_set1_ps(result.smallest)};
+    __m128 biggest{_mm_set1_ps(result.biggest)};
+    size_t i{0};
+    for (; i + 4 <= count; i += 4) {
+      const __m128 values{_mm_loadu_ps(samples + i)};
+      smallest = _mm_min_ps(values, smallest);
+      biggest = _mm_max_ps(values, biggest);
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, smallest);
+    min_max_scalar(lanes, 4, result);
+    _mm_storeu_ps(lanes, biggest);
+    min_max_scalar(lanes, 4, result);
+    return i;
+  }
+
+  __attribute__((target("avx2")))
+  inline size_t min_max_avx2(const float* const samples, const size_t count, MinMax<float>& result) {
+    __m256 smallest{_mm256_set1_ps(result.smallest)};
+    __m256 biggest{_mm256_set1_ps(result.biggest)};
+    size_t i{0};
+    for (; i + 8 <= count; i += 8) {
+      const __m256 values{_mm256_loadu_ps(samples + i)};
+      smallest = _mm256_min_ps(values, smallest);
+      biggest = _mm256_max_ps(values, biggest);
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, smallest);
+    min_max_scalar(lanes, 8, result);
+    _mm256_storeu_ps(lanes, biggest);
+    min_max_scalar(lanes, 8, result);
+    return i;
+  }
+
+  __attribute__((target("sse2")))
+  inline size_t min_max_sse2(const int16_t* const samples, const size_t count, MinMax<int16_t>& result) {
+    __m128i smallest{_mm_set1_epi16(result.smallest)};
+    __m128i biggest{_mm_set1_epi16(result.biggest)};
+    size_t i{0};
+    for (; i + 8 <= count; i += 8) {
+      const __m128i values{_mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i))};
+      smallest = _mm_min_epi16(smallest, values);
+      biggest = _mm_max_epi16(biggest, values);
+    }
+    int16_t lanes[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), smallest);
+    min_max_scalar(lanes, 8, result);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), biggest);
+    min_max_scalar(lanes, 8, result);
+    return i;
+  }
+
+  __attribute__((target("avx2")))
+  inline size_t min_max_avx2(const int16_t* const samples, const size_t count, MinMax<int16_t>& result) {
+    __m256i smallest{_mm256_set1_epi16(result.smallest)};
+    __m256i biggest{_mm256_set1_epi16(result.biggest)};
+    size_t i{0};
+    for (; i + 16 <= count; i += 16) {
+      const __m256i values{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples + i))};
+      smallest = _mm256_min_epi16(smallest, values);
+      biggest = _mm256_max_epi16(biggest, values);
+    }
+    int16_t lanes[16];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), smallest);
+    min_max_scalar(lanes, 16, result);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), biggest);
+    min_max_scalar(lanes, 16, result);
+    return i;
+  }
+
+  __attribute__((target("sse2")))
+  inline size_t scale_sse2(float* const samples, const size_t count, const float factor) {
+    const __m128 factors{_mm_set1_ps(factor)};
+    size_t i{0};
+    for (; i + 4 <= count; i += 4) {
+      _mm_storeu_ps(samples + i, _mm_mul_ps(_mm_loadu_ps(samples + i), factors));
+    }
+    return i;
+  }
+
+  __attribute__((target("avx2")))
+  inline size_t scale_avx2(float* const samples, const size_t count, const float factor) {
+    const __m256 factors{_mm256_set1_ps(factor)};
+    size_t i{0};
+    for (; i + 8 <= count; i += 8) {
+      _mm256_storeu_ps(samples + i, _mm256_mul_ps(_mm256_loadu_ps(samples + i), factors));
+    }
+    return i;
+  }
+
+  //The lower and upper halves of the 32 bit products are interleaved to the full products, which are packed back to 16 bits with saturation.
+  __attribute__((target("sse2")))
+  inline size_t scale_sse2(int16_t* const samples, const size_t count, const int16_t factor) {
+    const __m128i factors{_mm_set1_epi16(factor)};
+    size_t i{0};
+    for (; i + 8 <= count; i += 8) {
+      __m128i* const values{reinterpret_cast<__m128i*>(samples + i)};
+      const __m128i loaded{_mm_loadu_si128(values)};
+      const __m128i lower{_mm_mullo_epi16(loaded, factors)};
+      const __m128i upper{_mm_mulhi_epi16(loaded, factors)};
+      _mm_storeu_si128(values, _mm_packs_epi32(_mm_unpacklo_epi16(lower, upper), _mm_unpackhi_epi16(lower, upper)));
+    }
+    return i;
+  }
+
+  __attribute__((target("avx2")))
+  inline size_t scale_avx2(int16_t* const samples, const size_t count, const int16_t factor) {
+    const __m256i factors{_mm256_set1_epi16(factor)};
+    size_t i{0};
+    for (; i + 16 <= count; i += 16) {
+      __m256i* const values{reinterpret_cast<__m256i*>(samples + i)};
+      const __m256i loaded{_mm256_loadu_si256(values)};
+      const __m256i lower{_mm256_mullo_epi16(loaded, factors)};
+      const __m256i upper{_mm256_mulhi_epi16(loaded, factors)};
+      _mm256_storeu_si256(values, _mm256_packs_epi32(_mm256_unpacklo_epi16(lower, upper), _mm256_unpackhi_epi16(lower, upper)));
+    }
+    return i;
+  }
+
+  __attribute__((target("sse2")))
+  inline size_t clamp_sse2(float* const samples, const size_t count, const float lowest, const float highest) {
+    const __m128 lowests{_mm_set1_ps(lowest)};
+    const __m128 highests{_mm_set1_ps(highest)};
+    size_t i{0};
+    for (; i + 4 <= count; i += 4) {
+      _mm_storeu_ps(samples + i, _mm_max_ps(lowests, _mm_min_ps(highests, _mm_loadu_ps(samples + i))));
+    }
+    return i;
+  }
+
+  __attribute__((target("avx2")))
+  inline size_t clamp_avx2(float* const samples, const size_t count, const float lowest, const float highest) {
+    const __m256 lowests{_mm256_set1_ps(lowest)};
+    const __m256 highests{_mm256_set1_ps(highest)};
+    size_t i{0};
+    for (; i + 8 <= count; i += 8) {
+      _mm256_storeu_ps(samples + i, _mm256_max_ps(lowests, _mm256_min_ps(highests, _mm256_loadu_ps(samples + i))));
+    }
+    return i;
+  }
+
+  __attribute__((target("sse2")))
+  inline size_t clamp_sse2(int16_t* const samples, const size_t count, const int16_t lowest, const int16_t highest) {
+    const __m128i lowests{_mm_set1_epi16(lowest)};
+    const __m128i highests{_mm_set1_epi16(highest)};
+    size_t i{0};
+    for (; i + 8 <= count; i += 8) {
+      __m128i* const values{reinterpret_cast<__m128i*>(samples + i)};
+      _mm_storeu_si128(values, _mm_max_epi16(_mm_min_epi16(_mm_loadu_si128(values), highests), lowests));
+    }
+    return i;
+  }
+
+  __attribute__((target("avx2")))
+  inline size_t clamp_avx2(int16_t* const samples, const size_t count, const int16_t lowest, const int16_t highest) {
+    const __m256i lowests{_mm256_set1_epi16(lowest)};
+    const __m256i highests{_mm256_set1_epi16(highest)};
+    size_t i{0};
+    for (; i + 16 <= count; i += 16) {
+      __m256i* const values{reinterpret_cast<__m256i*>(samples + i)};
+      _mm256_storeu_si256(values, _mm256_max_epi16(_mm256_min_epi16(_mm256_loadu_si256(values), highests), lowests));
+    }
+    return i;
+  }
+
+#endif
+
+}
+
+//adds up all samples
+//The vector versions add in a different order, so float sums can differ from a plain loop in the last bits.
+inline float sum(const ArrayView<const float> samples) {
+  size_t done{0};
+  float result{0};
+#ifdef ARRAY_LIB_X86_SIMD
+  switch (array_lib_internal::simd_level()) {
+    case array_lib_internal::SimdLevel::avx2: done = array_lib_internal::sum_avx2(samples.data(), samples.length(), result); break;
+    case array_lib_internal::SimdLevel::sse2: done = array_lib_internal::sum_sse2(samples.data(), samples.length(), result); break;
+    case array_lib_internal::SimdLevel::scalar: break;
+  }
+#endif
+  return result + array_lib_internal::sum_scalar(samples.data() + done, samples.length() - done);
+}
+
+inline int64_t sum(const ArrayView<const int16_t> samples) {
+  size_t done{0};
+  int64_t result{0};
+#ifdef ARRAY_LIB_X86_SIMD
+  switch (array_lib_internal::simd_level()) {
+    case array_lib_internal::SimdLevel::avx2: done = array_lib_internal::sum_avx2(samples.data(), samples.length(), result); break;
+    case array_lib_internal::SimdLevel::sse2: done = array_lib_internal::sum_sse2(samples.data(), samples.length(), result); break;
+    case array_lib_internal::SimdLevel::scalar: break;
+  }
+#endif
+  return result + array_lib_internal::sum_scalar(samples.data() + done, samples.length() - done);
+}
+
+//multiplies the samples with the same index and adds up the products
+//If the arrays have different lengths, the program will crash.
+inline float dot(const ArrayView<const float> first, const ArrayView<const float> second) {
+  if (first.length() != second.length()) {
+    abort();
+  }
+  size_t done{0};
+  float result{0};
+#ifdef ARRAY_LIB_X86_SIMD
+  switch (array_lib_internal::simd_level()) {
+    case array_lib_internal::SimdLevel::avx2: done = array_lib_internal::dot_avx2(first.data(), second.data(), first.length(), result); break;
+    case array_lib_internal::SimdLevel::sse2: done = array_lib_internal::dot_sse2(first.data(), second.data(), first.length(), result); break;
+    case array_lib_internal::SimdLevel::scalar: break;
+  }
+#endif
+  return result + array_lib_internal::dot_scalar(first.data() + done, second.data() + done, first.length() - done);
+}
+
+inline int64_t dot(const ArrayView<const int16_t> first, const ArrayView<const int16_t> second) {
+  if (first.length() != second.length()) {
+    abort();
+  }
+  size_t done{0};
+  int64_t result{0};
+#ifdef ARRAY_LIB_X86_SIMD
+  switch (array_lib_internal::simd_level()) {
+    case array_lib_internal::SimdLevel::avx2: done = array_lib_internal::dot_avx2(first.data(), second.data(), first.length(), result); break;
+    case array_lib_internal::SimdLevel::sse2: done = array_lib_internal::dot_sse2(first.data(), second.data(), first.length(), result); break;
+    case array_lib_internal::SimdLevel::scalar: break;
+  }
+#endif
+  return result + array_lib_internal::dot_scalar(first.data() + done, second.data() + done, first.length() - done);
+}
+
+//finds the smallest and the biggest sample
+//If there are no samples, the program will crash.
+//Samples which are NaN are ignored, unless all of them are NaN, then the result is NaN too.
+//The vector versions give min and max the sample as the first operand, so they return the other one for NaN.
+inline MinMax<float> min_max(const ArrayView<const float> samples) {
+  if (samples.length() == 0) {
+    abort();
+  }
+  //The search starts at the first sample which isn't NaN, because NaN compares false with everything and would stick.
+  size_t first{0};
+  while (first + 1 != samples.length() && samples.data()[first] != samples.data()[first]) {
+    ++first;
+  }
+  const float* const rest{samples.data() + first};
+  const size_t count{samples.length() - first};
+  size_t done{0};
+  MinMax<float> result{rest[0], rest[0]};
+#ifdef ARRAY_LIB_X86_SIMD
+  switch (array_lib_internal::simd_level()) {
+    case array_lib_internal::SimdLevel::avx2: done = array_lib_internal::min_max_avx2(rest, count, result); break;
+    case array_lib_internal::SimdLevel::sse2: done = array_lib_internal::min_max_sse2(rest, count, result); break;
+    case array_lib_internal::SimdLevel::scalar: break;
+  }
+#endif
+  array_lib_internal::min_max_scalar(rest + done, count - done, result);
+  return result;
+}
+
+inline MinMax<int16_t> min_max(const ArrayView<const int16_t> samples) {
+  if (samples.length() == 0) {
+    abort();
+  }
+  size_t done{0};
+  MinMax<int16_t> result{samples[0], samples[0]};
+#ifdef ARRAY_LIB_X86_SIMD
+  switch (array_lib_internal::simd_level()) {
+    case array_lib_internal::SimdLevel::avx2: done = array_lib_internal::min_max_avx2(samples.data(), samples.length(), result); break;
+    case array_lib_internal::SimdLevel::sse2: done = array_lib_internal::min_max_sse2(samples.data(), samples.length(), result); break;
+    case array_lib_internal::SimdLevel::scalar: break;
+  }
+#endif
+  array_lib_internal::min_max_scalar(samples.data() + done, samples.length() - done, result);
+  return result;
+}
+
+//multiplies every sample with factor
+inline void scale(const ArrayView<float> samples, const float factor) {
+  size_t done{0};
+#ifdef ARRAY_LIB_X86_SIMD
+  switch (array_lib_internal::simd_level()) {
+    case array_lib_internal::SimdLevel::avx2: done = array_lib_internal::scale_avx2(samples.data(), samples.length(), factor); break;
+    case array_lib_internal::SimdLevel::sse2: done = array_lib_internal::scale_sse2(samples.data(), samples.length(), factor); break;
+    case array_lib_internal::SimdLevel::scalar: break;
+  }
+#endif
+  array_lib_internal::scale_scalar(samples.data() + done, samples.length() - done, factor);
+}
+
+//Products which don't fit into 16 bits become the smallest or biggest int16_t.
+inline void scale(const ArrayView<int16_t> samples, const int16_t factor) {
+  size_t done{0};
+#ifdef ARRAY_LIB_X86_SIMD
+  switch (array_lib_internal::simd_level()) {
+    case array_lib_internal::SimdLevel::avx2: done = array_lib_internal::scale_avx2(samples.data(), samples.length(), factor); break;
+    case array_lib_internal::SimdLevel::sse2: done = array_lib_internal::scale_sse2(samples.data(), samples.length(), factor); break;
+    case array_lib_internal::SimdLevel::scalar: break;
+  }
+#endif
+  array_lib_internal::scale_scalar(samples.data() + done, samples.length() - done, factor);
+}
+
+//sets samples which are smaller than lowest to lowest and samples which are bigger than highest to highest
+//If lowest is bigger than highest, the program will crash.
+//Samples which are NaN stay NaN. The vector versions give min and max the sample as the second operand, which they return for NaN.
+inline void clamp(const ArrayView<float> samples, const float lowest, const float highest) {
+  if (lowest > highest) {
+    abort();
+  }
+  size_t done{0};
+#ifdef ARRAY_LIB_X86_SIMD
+  switch (array_lib_internal::simd_level()) {
+    case array_lib_internal::SimdLevel::avx2: done = array_lib_internal::clamp_avx2(samples.data(), samples.length(), lowest, highest); break;
+    case array_lib_internal::SimdLevel::sse2: done = array_lib_internal::clamp_sse2(samples.data(), samples.length(), lowest, highest); break;
+    case array_lib_internal::SimdLevel::scalar: break;
+  }
+#endif
+  array_lib_internal::clamp_scalar(samples.data() + done, samples.length() - done, lowest, highest);
+}
+
+inline void clamp(const ArrayView<int16_t> samples, const int16_t lowest, const int16_t highest) {
+  if (lowest > highest) {
+    abort();
+  }
+  size_t done{0};
+#ifdef ARRAY_LIB_X86_SIMD
+  switch (array_lib_internal::simd_level()) {
+    case array_lib_internal::SimdLevel::avx2: done = array_lib_internal::clamp_avx2(samples.data(), samples.length(), lowest, highest); break;
+    case array_lib_internal::SimdLevel::sse2: done = array_lib_internal::clamp_sse2(samples.data(), samples.length(), lowest, highest); break;
+    case array_lib_internal::SimdLevel::scalar: break;
+  }
+#endif
+  array_lib_internal::clamp_scalar(samples.data() + done, samples.length() - done, lowest, highest);
+}
+
+//counts the samples into bins which are 2^bin_shift wide, starting at lowest, and adds the counts to the bins
+//Samples below the first bin are counted in the first bin, samples above the last bin in the last bin.
+//Counting can't be done with vectors, so this is a plain loop everywhere.
+//If there are no bins or bin_shift is bigger than 16, the program will crash.
+inline void histogram(const ArrayView<const int16_t> samples, const int16_t lowest, const uint8_t bin_shift, const ArrayView<uint32_t> bins) {
+  if (bins.length() == 0 || bin_shift > 16) {
+    abort();
+  }
+  uint32_t* const counts{bins.data()};
+  const size_t last_bin{bins.length() - 1};
+  for (const int16_t sample : samples) {
+    const int32_t offset{int32_t{sample} - lowest};
+    const size_t bin{offset < 0 ? 0 : static_cast<size_t>(offset) >> bin_shift};
+    ++counts[bin < last_bin ? bin : last_bin];
+  }
+}
+
+#endif //TIMON_PASSLICK_ARRAY_LIB_ALGORITHMS
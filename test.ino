@@ -1,6 +1,93 @@
 #include "array_lib.h"
+#include "array_lib_algorithms.h"
 #include <assert.h>
 
+//sums up any array without copying it
+int sum_of(const ArrayView<const int> view) {
+  int sum{0};
+  for (const int element : view) {
+    sum += element;
+  }
+  return sum;
+}
+
+//an allocator which counts the blocks it has given out
+struct CountingAllocator {
+  static int blocks;
+
+  static void* allocate(const size_t bytes) {
+    ++blocks;
+    return malloc(bytes);
+  }
+
+  static void deallocate(void* const block) {
+    --blocks;
+    free(block);
+  }
+};
+int CountingAllocator::blocks{0};
+
+const FlashArray<long, 4> flash_table PROGMEM {1, 10, 100, 1000};
+static_assert(flash_table.length() == 4, "flash_table has not 4 elements");
+
+constexpr unsigned char crc8_step(const unsigned char crc, const int bits) {
+  return bits == 0 ? crc : crc8_step((crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1, bits - 1);
+}
+
+//the table for the CRC-8 with the polynomial 0x07
+struct Crc8Table {
+  constexpr unsigned char operator () (const size_t i) const {
+    return crc8_step(i, 8);
+  }
+};
+
+constexpr int cube(const size_t i) {
+  return i * i * i;
+}
+
+constexpr auto crc8_table = make_stack_array<unsigned char, 256>(Crc8Table{});
+static_assert(crc8_table[1] == 0x07 && crc8_table[0x80] == 0x89 && crc8_table[255] == 0xf3, "crc8_table is wrong");
+constexpr auto cubes = make_stack_array<int, 5>(cube);
+static_assert(cubes[4] == 64 && cubes.length() == 5, "cubes is wrong");
+
+constexpr StackArray<int, 10> unsorted_ids{42, 7, 19, 3, 88, 19, 56, 1, 23, 64};
+constexpr auto sorted_ids = sorted(unsorted_ids);
+static_assert(sorted_ids[0] == 1 && sorted_ids[3] == 19 && sorted_ids[4] == 19 && sorted_ids[9] == 88, "sorted_ids is not sorted");
+static_assert(lower_bound(sorted_ids, 20) == 5 && lower_bound(sorted_ids, 100) == 10, "lower_bound is wrong");
+static_assert(binary_search(sorted_ids, 56) && !binary_search(sorted_ids, 57), "binary_search is wrong");
+static_assert(find(unsorted_ids, 19) == 2 && find(unsorted_ids, 20) == 10, "find is wrong");
+constexpr auto eytzinger_ids = eytzinger(sorted_ids);
+static_assert(eytzinger_ids[0] == 42 && eytzinger_ids[eytzinger_lower_bound(eytzinger_ids, 20)] == 23, "eytzinger_ids is wrong");
+static_assert(eytzinger_ids[eytzinger_lower_bound(eytzinger_ids, 2)] == 3 && eytzinger_lower_bound(eytzinger_ids, 89) == 10, "eytzinger_lower_bound is wrong");
+
+struct Measurement {
+  long time;
+  float value;
+};
+
+static_assert(TriviallyRelocatable<Measurement>::value && TriviallyRelocatable<int*>::value, "plain values are trivially relocatable");
+static_assert(!TriviallyRelocatable<HeapArray<int>>::value && !TriviallyDestructible<HeapArray<int>>::value, "a HeapArray is not trivially destructible");
+
+//finds out whether an Array can become a View
+template <typename View, typename Array>
+constexpr auto converts_to_view(int) -> decltype(View{*static_cast<Array*>(nullptr)}, true) {
+  return true;
+}
+
+template <typename View, typename Array>
+constexpr bool converts_to_view(long) {
+  return false;
+}
+
+struct Reading : Measurement {
+  int sensor;
+};
+
+static_assert(converts_to_view<ArrayView<const Measurement>, StackArray<Measurement, 3>>(0), "a StackArray can be viewed as const");
+static_assert(!converts_to_view<ArrayView<Measurement>, const StackArray<Measurement, 3>>(0), "a const StackArray can't be viewed as mutable");
+static_assert(!converts_to_view<ArrayView<Measurement>, StackArray<Reading, 3>>(0), "Readings are bigger than Measurements, so they can't be viewed as Measurements");
+static_assert(!converts_to_view<ArrayView<const Measurement>, GrowingArray<Reading>>(0), "Readings are bigger than Measurements, so they can't be viewed as Measurements");
+
 void setup() {
   constexpr StackArray<int, 3> a{2, 4, 6};
   static_assert(a[0] == 2, "a[0] is not 2");
@@ -33,6 +120,357 @@ void setup() {
   assert(d[1] == 4);
   assert(d[2] == 6);
   assert(d.length() == 3);
+
+  GrowingArray<long> e;
+  for (long i{0}; i != 100; ++i) {
+    e.push(i * i);
+  }
+  for (long i{0}; i != 100; ++i) {
+    assert(e[i] == i * i);
+  }
+  assert(e.length() == 100);
+  e.shrink_to_fit();
+  assert(e.capacity() == 100);
+  assert(e[99] == 99 * 99);
+
+  GrowingArray<int> f{64};
+  assert(f.capacity() == 64);
+  for (int i{0}; i != 64; ++i) {
+    f.push(i);
+  }
+  assert(f.capacity() == 64);
+  f.reserve(10);
+  assert(f.capacity() == 64);
+
+  GrowingArray<HeapArray<int>> g;
+  g.push(HeapArray<int>{2});
+  g.emplace(5)[4] = 8;
+  for (int i{0}; i != 10; ++i) {
+    g.emplace(i + 1);
+  }
+  assert(g[0].length() == 2);
+  assert(g[1].length() == 5);
+  assert(g[1][4] == 8);
+  assert(g[11].length() == 10);
+  assert(g.length() == 12);
+
+  GrowingArray<int> h;
+  GrowingArray<int, GrowByDoubling> i;
+  GrowingArray<int, GrowByStep<4>> j;
+  GrowingArray<int, GrowToPowerOfTwo> k;
+  for (int n{0}; n != 9; ++n) {
+    h.push(n);
+    i.push(n);
+    j.push(n);
+    k.push(n);
+  }
+  assert(h.capacity() == 12);
+  assert(i.capacity() == 16);
+  assert(j.capacity() == 12);
+  assert(k.capacity() == 16);
+  assert(h[8] == 8 && i[8] == 8 && j[8] == 8 && k[8] == 8);
+
+  {
+    HeapArray<int, CountingAllocator> l{4};
+    GrowingArray<HeapArray<int, CountingAllocator>, GrowByHalf, CountingAllocator> m;
+    for (int n{0}; n != 5; ++n) {
+      m.emplace(n + 1);
+    }
+    l[3] = 7;
+    HeapArray<int, CountingAllocator> n{l.copy()};
+    assert(n[3] == 7);
+    assert(m[4].length() == 5);
+    assert(CountingAllocator::blocks == 8);
+  }
+  assert(CountingAllocator::blocks == 0);
+
+  using Arena = ArenaAllocator<256>;
+  const size_t start{Arena::mark()};
+  {
+    HeapArray<int, Arena> o{3};
+    GrowingArray<int, GrowByHalf, Arena> p;
+    p.push(0);
+    int* const first{&p[0]};
+    for (int n{1}; n != 20; ++n) {
+      p.push(n);
+    }
+    assert(p[19] == 19);
+    assert(&p[0] == first); //p grew in place
+  }
+  Arena::reset(start);
+  assert(Arena::available() == 256);
+
+  using Pool = PoolAllocator<8, 2>;
+  {
+    HeapArray<char, Pool> q{8};
+    HeapArray<char, Pool> r{5};
+    q[7] = 'q';
+    r[4] = 'r';
+    assert(Pool::allocate(1) == nullptr);
+    assert(q[7] == 'q' && r[4] == 'r');
+  }
+  for (int n{0}; n != 10; ++n) {
+    HeapArray<char, Pool> s{8};
+    HeapArray<char, Pool> t{8};
+  }
+
+  {
+    SmallGrowingArray<int, 4, GrowByHalf, CountingAllocator> u;
+    SmallGrowingArray<HeapArray<int>, 2, GrowByHalf, CountingAllocator> v;
+    for (int n{0}; n != 4; ++n) {
+      u.push(n);
+    }
+    v.emplace(1);
+    assert(u.capacity() == 4);
+    assert(CountingAllocator::blocks == 0);
+    SmallGrowingArray<HeapArray<int>, 2, GrowByHalf, CountingAllocator> w{static_cast<decltype(v)&&>(v)};
+    assert(w[0].length() == 1 && v.length() == 0);
+    u.push(4);
+    w.emplace(2);
+    w.emplace(3);
+    assert(CountingAllocator::blocks == 2);
+    assert(u[4] == 4 && u[0] == 0);
+    assert(w[2].length() == 3 && w[0].length() == 1);
+    SmallGrowingArray<int, 4, GrowByHalf, CountingAllocator> x{u.copy()};
+    assert(x[4] == 4);
+    x.shrink_to_fit();
+    assert(x.capacity() == 5);
+    assert(CountingAllocator::blocks == 3);
+  }
+  assert(CountingAllocator::blocks == 0);
+
+  StaticVector<HeapArray<int>, 3> y;
+  y.emplace(1);
+  y.push(HeapArray<int>{2});
+  y.emplace(3);
+  assert(y.capacity() == 3);
+  assert(y.pop().length() == 3);
+  assert(y.length() == 2);
+  y.clear();
+  assert(y.length() == 0);
+  y.emplace(4);
+  assert(y[0].length() == 4);
+
+  RingBuffer<int, 4> z;
+  int popped[6];
+  assert(z.push(1) && z.push(2) && z.push(3));
+  assert(z.pop(popped[0]) && popped[0] == 1);
+  const int pushed[]{4, 5, 6, 7};
+  assert(z.push_n(pushed, length(pushed)) == 2);
+  assert(!z.push(8));
+  const RingBuffer<int, 4>& constant_z{z};
+  assert(constant_z.length() == 4 && constant_z.capacity() == 4);
+  assert(z.pop_n(popped, length(popped)) == 4);
+  assert(popped[0] == 2 && popped[1] == 3 && popped[2] == 4 && popped[3] == 5);
+  assert(!z.pop(popped[0]));
+
+  constexpr StackArray<int, 2, UncheckedBounds> aa{1, 3};
+  static_assert(aa[1] == 3 && aa.at(0) == 1 && aa.unchecked(1) == 3, "aa is not {1, 3}");
+  HeapArray<int, MallocAllocator, UncheckedBounds> ab{2};
+  ab.unchecked(1) = 5;
+  assert(ab[1] == 5 && ab.at(1) == 5);
+  GrowingArray<int> ac;
+  ac.push(7);
+  assert(ac.unchecked(0) == 7 && ac.at(0) == 7);
+
+  int total{0};
+  for (const int element : b) {
+    total += element;
+  }
+  for (int& element : c) {
+    element *= 2;
+  }
+  for (const int element : c) {
+    total += element;
+  }
+  const GrowingArray<int>& constant_d{d};
+  for (const int element : constant_d) {
+    total += element;
+  }
+  assert(total == 12 + 24 + 12);
+  assert(c.data() == &c[0] && d.end() - d.begin() == 3);
+  static_assert(a.end() - a.begin() == 3 && *a.data() == 2, "a has no 3 elements starting with 2");
+
+  static constexpr StackArray<int, 3> table{2, 4, 6};
+  constexpr ArrayView<const int, 3> ad{table};
+  static_assert(ad[2] == 6 && ad.length() == 3, "ad is not a view of table");
+  int ae[]{1, 2, 3, 4, 5};
+  ArrayView<int> af{ae};
+  assert(sum_of(af) == 15);
+  assert(sum_of(af.subview(1, 3)) == 9);
+  assert(sum_of(af.first(2)) == 3 && sum_of(af.last(2)) == 9);
+  assert(af.last<2>()[0] == 4 && sizeof(af.last<2>()) == sizeof(int*));
+  af[0] = 10;
+  assert(ae[0] == 10);
+  assert(sum_of(b) == 12 && sum_of(c) == 24 && sum_of(d) == 12 && sum_of(ad) == 12);
+
+  GrowingArray<int> ag{af.first(2)};
+  ag.append(b);
+  ag.append(ae + 2, 3);
+  ag.append(ag);
+  assert(ag.length() == 16 && sum_of(ag) == 2 * (12 + 12 + 12));
+
+  GrowingArray<Measurement> ai;
+  for (long n{0}; n != 20; ++n) {
+    ai.push(Measurement{n, n * 0.5f});
+  }
+  GrowingArray<Measurement> aj{ai.copy()};
+  HeapArray<Measurement> ak{2};
+  ak[1] = aj[19];
+  assert(ak.copy()[1].time == 19 && aj[19].value == 9.5f);
+
+  HeapArray<unsigned char> al{100, 0};
+  HeapArray<long> am{3, 7};
+  HeapArray<long> an{4, [](size_t i) { return long(i * i); }};
+  HeapArray<Measurement> ao{4, uninitialized};
+  ao[3] = Measurement{1, 2};
+  assert(al[99] == 0 && am[2] == 7 && an[3] == 9 && ao[3].time == 1);
+
+  {
+    GrowingArray<int, GrowByHalf, CountingAllocator> ap;
+    SmallGrowingArray<HeapArray<int>, 2, GrowByHalf, CountingAllocator> aq;
+    ap.append(b);
+    ap.append(b);
+    ap.push(7);
+    aq.emplace(3);
+    const int* const first{ap.data()};
+    HeapArray<int, CountingAllocator> ar{ap.freeze()};
+    HeapArray<HeapArray<int>, CountingAllocator> as{aq.freeze()};
+    assert(ar.data() == first && ar.length() == 7 && ar[6] == 7);
+    assert(as.length() == 1 && as[0].length() == 3);
+    assert(ap.length() == 0 && aq.length() == 0);
+    assert(CountingAllocator::blocks == 2);
+  }
+  assert(CountingAllocator::blocks == 0);
+
+  GrowingArray<int> at{ae};
+  at.insert(0, 0);
+  at.insert(6, 6);
+  at.insert(3, at[3]);
+  at.erase(1);
+  at.erase(2, 4);
+  at.swap_remove(0);
+  const int expected_at[]{6, 2, 4};
+  assert(at.length() == 4 && at.pop() == 5);
+  for (size_t n{0}; n != at.length(); ++n) {
+    assert(at[n] == expected_at[n]);
+  }
+  GrowingArray<HeapArray<int>> au;
+  for (int n{1}; n != 6; ++n) {
+    au.emplace(n);
+  }
+  au.insert(1, HeapArray<int>{9});
+  au.erase(3, 5);
+  au.erase(1, 1);
+  au.swap_remove(0);
+  assert(au.length() == 3 && au[0].length() == 5 && au[1].length() == 9 && au[2].length() == 2);
+
+  HeapArray<int, Arena> av{4, 1};
+  int* const av_first{av.data()};
+  av.resize(40);
+  av[39] = 2;
+  av.resize(5);
+  assert(av.data() == av_first && av[3] == 1 && av.length() == 5);
+  HeapArray<GrowingArray<int>> aw{2};
+  aw[1].push(3);
+  aw.resize(4);
+  aw[3].push(4);
+  aw.resize(3);
+  assert(aw.length() == 3 && aw[1][0] == 3 && aw[2].length() == 0);
+  aw.resize(0);
+  aw.resize(1);
+  assert(aw.length() == 1 && aw[0].length() == 0);
+  Arena::reset(start);
+
+  long flash_sum{0};
+  for (size_t n{0}; n != flash_table.length(); ++n) {
+    flash_sum += flash_table[n];
+  }
+  assert(flash_sum == 1111 && flash_table.at(3) == 1000);
+
+  for (int n{0}; n != 90; ++n) {
+    const size_t index{eytzinger_lower_bound(eytzinger_ids, n)};
+    const size_t sorted_index{lower_bound(sorted_ids, n)};
+    assert(index == eytzinger_ids.length() ? sorted_index == sorted_ids.length() : eytzinger_ids[index] == sorted_ids[sorted_index]);
+  }
+
+  HeapArray<long> ids{100, [](size_t i) { return long(i * 3); }};
+  SortedIndex<long> eytzinger_index{ids};
+  SortedIndex<long, BlockedLayout<4>> blocked_index{ids};
+  for (long n{-1}; n != 300; ++n) {
+    const long* const expected{n <= 297 ? &ids[(n + 2) / 3] : nullptr};
+    const long* const from_eytzinger{eytzinger_index.lower_bound(n)};
+    const long* const from_blocked{blocked_index.lower_bound(n)};
+    assert(expected == nullptr ? from_eytzinger == nullptr && from_blocked == nullptr : *from_eytzinger == *expected && *from_blocked == *expected);
+  }
+  assert(eytzinger_index.contains(297) && !blocked_index.contains(298) && blocked_index.contains(0));
+  for (long n{-1}; n != 300; ++n) {
+    const size_t expected{n < 0 ? 0 : size_t(n + 2) / 3};
+    assert(eytzinger_index.rank(n) == expected && blocked_index.rank(n) == expected);
+  }
+
+  HeapArray<int16_t> samples{101, [](size_t i) { return int16_t((int(i) * 37 % 200 - 100) * 300); }};
+  int64_t expected_sum{0};
+  int64_t expected_dot{0};
+  for (const int16_t sample : samples) {
+    expected_sum += sample;
+    expected_dot += int32_t{sample} * sample;
+  }
+  assert(sum(samples) == expected_sum && dot(samples, samples) == expected_dot);
+  assert(min_max(samples).smallest == -30000 && min_max(samples).biggest == 29700);
+  StackArray<int16_t, 20> loudest{};
+  for (int16_t& sample : loudest) {
+    sample = INT16_MIN;
+  }
+  assert(dot(loudest, loudest) == int64_t{20} << 30);
+  StackArray<uint32_t, 4> bins{};
+  histogram(samples, -15000, 13, bins);
+  assert(bins[0] + bins[1] + bins[2] + bins[3] == samples.length() && bins[0] == 39 && bins[3] == 34);
+  scale(samples, 2);
+  assert(samples[0] == INT16_MIN && samples[3] == 6600);
+  clamp(samples, -1000, 1000);
+  assert(min_max(samples).smallest == -1000 && min_max(samples).biggest == 1000);
+
+  HeapArray<float> levels{99, [](size_t i) { return float(i) - 49; }};
+  assert(sum(levels) == 0 && dot(levels, levels) == 80850);
+  scale(levels, 0.5f);
+  clamp(levels, -10, 20);
+  assert(min_max(levels).smallest == -10 && min_max(levels).biggest == 20 && levels[60] == 5.5f);
+  float not_a_number{0};
+  not_a_number /= not_a_number;
+  levels[3] = not_a_number;
+  levels[98] = not_a_number;
+  levels[0] = not_a_number;
+  const MinMax<float> level_range{min_max(levels)};
+  assert(level_range.smallest == -10 && level_range.biggest == 20);
+  const float only_nan[]{not_a_number, not_a_number};
+  assert(min_max(only_nan).smallest != min_max(only_nan).smallest);
+  clamp(levels, -5, 5);
+  assert(levels[3] != levels[3] && levels[98] != levels[98] && levels[4] == -5 && levels[97] == 5);
+
+  {
+    HeapArray<float, AlignedAllocator<32, CountingAllocator>> aligned_levels{13, 1.5f};
+    assert(reinterpret_cast<size_t>(aligned_levels.data()) % 32 == 0 && sum(aligned_levels) == 19.5f);
+    GrowingArray<double, GrowByHalf, AlignedAllocator<64, CountingAllocator>> aligned_readings;
+    for (int n{0}; n != 50; ++n) {
+      aligned_readings.push(n);
+      assert(reinterpret_cast<size_t>(aligned_readings.data()) % 64 == 0 && aligned_readings[n / 2] == n / 2);
+    }
+    SmallGrowingArray<char, 3, GrowByHalf, AlignedAllocator<16>> aligned_letters;
+    aligned_letters.push('a');
+    assert(reinterpret_cast<size_t>(aligned_letters.data()) % 16 == 0);
+    assert(CountingAllocator::blocks == 2);
+  }
+  assert(CountingAllocator::blocks == 0);
+  {
+    GrowingArray<int, GrowByHalf, AlignedAllocator<16, Arena>> aligned_in_arena{4};
+    const int* const first_block{aligned_in_arena.data()};
+    for (int n{0}; n != 20; ++n) {
+      aligned_in_arena.push(n);
+    }
+    assert(aligned_in_arena.data() == first_block && reinterpret_cast<size_t>(first_block) % 16 == 0);
+  }
+  Arena::reset(start);
 }
 
 void loop() {